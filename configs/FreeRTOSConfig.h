@@ -45,7 +45,13 @@
 
 #include "cycfg_system.h"
 
+#if defined(RADAR_STATIC_MEMORY_ENABLE) && (RADAR_STATIC_MEMORY_ENABLE == 1)
+/* All application tasks and sync objects are statically allocated, see
+   radar_rtos.c. The heap_4 arena only holds what the middleware allocates. */
+#define configTOTAL_HEAP_SIZE                       ( ( size_t ) ( 8 * 1024 ) )
+#else
 #define configTOTAL_HEAP_SIZE                       ( ( size_t ) ( CY_SRAM_SIZE - (64 * 1024)))
+#endif
 #define configUSE_DAEMON_TASK_STARTUP_HOOK          0
 #define configUSE_PREEMPTION                        1
 #define configUSE_IDLE_HOOK                         0
@@ -66,7 +72,16 @@
 #define configUSE_MALLOC_FAILED_HOOK                1
 #define configUSE_APPLICATION_TASK_TAG              0
 #define configUSE_COUNTING_SEMAPHORES               1
+#if defined(RADAR_RUNTIME_STATS_ENABLE) && (RADAR_RUNTIME_STATS_ENABLE == 1)
+/* Run-time stats clock, see radar_stats.c */
+extern void radar_stats_timer_init( void );
+extern uint32_t radar_stats_timer_read( void );
+#define configGENERATE_RUN_TIME_STATS               1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    radar_stats_timer_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()            radar_stats_timer_read()
+#else
 #define configGENERATE_RUN_TIME_STATS               0
+#endif
 #define configENABLE_FPU                            1
 #define configENABLE_MPU                            0
 #define configENABLE_TRUSTZONE                      0
@@ -96,6 +111,8 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay              1
 #define INCLUDE_xTaskIsTaskFinished     1
 #define INCLUDE_xTimerPendFunctionCall  1
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
+#define INCLUDE_xTaskGetIdleTaskHandle  1
 
 /*
 Interrupt nesting behavior configuration.
@@ -160,9 +177,26 @@ standard names. */
 #define HEAP_ALLOCATION_TYPE5                       (5)     /* heap_5.c*/
 #define NO_HEAP_ALLOCATION                          (0)
 
+#if defined(RADAR_STATIC_MEMORY_ENABLE) && (RADAR_STATIC_MEMORY_ENABLE == 1)
+#define configHEAP_ALLOCATION_SCHEME                (HEAP_ALLOCATION_TYPE4)
+#else
 #define configHEAP_ALLOCATION_SCHEME                (HEAP_ALLOCATION_TYPE3)
+#endif
+
+#if defined(RADAR_LOAD_ENABLE) && (RADAR_LOAD_ENABLE == 1)
+/* Idle time of the CPU load meter, see radar_load.c */
+extern void radar_load_task_switched_in( void *task );
+extern void radar_load_task_switched_out( void *task );
+#define traceTASK_SWITCHED_IN()     radar_load_task_switched_in( ( void * ) pxCurrentTCB )
+#define traceTASK_SWITCHED_OUT()    radar_load_task_switched_out( ( void * ) pxCurrentTCB )
+#endif
 
-#if defined(CY_CFG_PWR_SYS_IDLE_MODE) && \
+#if defined(RADAR_LOW_POWER_ENABLE) && (RADAR_LOW_POWER_ENABLE == 1)
+/* Application tickless idle handler, see radar_low_power.c */
+extern void radar_low_power_sleep( uint32_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xIdleTime ) radar_low_power_sleep( xIdleTime )
+#define configUSE_TICKLESS_IDLE     2
+#elif defined(CY_CFG_PWR_SYS_IDLE_MODE) && \
     ((CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_SLEEP) || \
     (CY_CFG_PWR_SYS_IDLE_MODE == CY_CFG_PWR_MODE_DEEPSLEEP))
 extern void vApplicationSleep( uint32_t xExpectedIdleTime );
@@ -31,8 +31,58 @@
 #include "cyabs_rtos.h"
 
 /* Header file for local tasks */
+#include "radar_boot.h"
+#include "radar_capture.h"
+#include "radar_console.h"
+#include "radar_event_bus.h"
+#include "radar_event_log.h"
+#include "radar_low_power.h"
+#include "radar_profile.h"
+#include "radar_profiler.h"
+#include "radar_rtos.h"
 #include "radar_task.h"
 #include "radar_terminal_ui.h"
+#include "radar_time.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Frame capture needs more bandwidth than the default baud rate provides */
+#if (RADAR_CAPTURE_ENABLE == 1)
+#define CONSOLE_BAUDRATE (RADAR_CAPTURE_BAUDRATE)
+#else
+#define CONSOLE_BAUDRATE (CY_RETARGET_IO_BAUDRATE)
+#endif
+
+/* The frame timing of the radar task must not depend on the console tasks,
+   whatever priorities the Makefile assigns */
+_Static_assert(RADAR_TASK_PRIORITY > RADAR_PRESENCE_TERMINAL_UI_TASK_PRIORITY,
+               "The radar task must outrank the terminal UI task");
+_Static_assert(RADAR_TASK_PRIORITY > RADAR_EVENT_LOG_TASK_PRIORITY, "The radar task must outrank the event log task");
+_Static_assert(RADAR_TASK_PRIORITY > RADAR_EVENT_BUS_TASK_PRIORITY,
+               "The radar task must outrank the event bus dispatcher task");
+#if (RADAR_CAPTURE_ENABLE == 1)
+_Static_assert(RADAR_TASK_PRIORITY > RADAR_CAPTURE_TASK_PRIORITY, "The radar task must outrank the capture task");
+#endif
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+#if (RADAR_STATIC_MEMORY_ENABLE == 1)
+/* Stacks and task control blocks of the application tasks */
+static StackType_t ifxradar_task_stack[RADAR_TASK_STACK_SIZE / sizeof(StackType_t)];
+static StaticTask_t ifxradar_task_tcb;
+static StackType_t ifxradar_task_terminal_ui_stack[RADAR_PRESENCE_TERMINAL_UI_TASK_STACK_SIZE / sizeof(StackType_t)];
+static StaticTask_t ifxradar_task_terminal_ui_tcb;
+static StackType_t ifxradar_task_event_log_stack[RADAR_EVENT_LOG_TASK_STACK_SIZE / sizeof(StackType_t)];
+static StaticTask_t ifxradar_task_event_log_tcb;
+static StackType_t ifxradar_task_event_bus_stack[RADAR_EVENT_BUS_TASK_STACK_SIZE / sizeof(StackType_t)];
+static StaticTask_t ifxradar_task_event_bus_tcb;
+#if (RADAR_CAPTURE_ENABLE == 1)
+static StackType_t ifxradar_task_capture_stack[RADAR_CAPTURE_TASK_STACK_SIZE / sizeof(StackType_t)];
+static StaticTask_t ifxradar_task_capture_tcb;
+#endif
+#endif
 
 /*******************************************************************************
  * Function Name: main
@@ -40,9 +90,11 @@
  * Summary:
  * This is the main function for example project that demonstrates presence
  * detection use case of radar. It sets up board support package, global
- * interrupts and UART. Two tasks are then created: one for presence
- * detection application, another for terminal UI to configure presence detection
- * parameters. Scheduler is then started.
+ * interrupts and UART, and powers up the radar sensors. Four tasks are then
+ * created: one for presence detection application, one for terminal UI to
+ * configure presence detection parameters, one that dispatches the presence
+ * events to their subscribers and one that prints them. Scheduler is then
+ * started.
  *
  * Parameters:
  *  none
@@ -61,34 +113,66 @@ int main(void)
         CY_ASSERT(0);
     }
 
+    /* Start the microsecond clock for timestamps, boot phases count from here */
+    radar_time_init();
+
     /* Enable global interrupts. */
     __enable_irq();
 
     /* Initialize retarget-io to use the debug UART port. */
-    result = cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX, CY_RETARGET_IO_BAUDRATE);
+    result = cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX, CONSOLE_BAUDRATE);
     if (result != CY_RSLT_SUCCESS)
     {
         CY_ASSERT(0);
     }
 
-    /* \x1b[2J\x1b[;H - ANSI ESC sequence to clear screen. */
-    printf("\x1b[2J\x1b[;H");
-    printf("============================================================\n");
-    printf("Connected Sensor Kit: Radar Presence Application on FreeRTOS\n");
-    printf("============================================================\n\n");
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1) || (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+    /* Move console output and input to rings served by the UART interrupt */
+    radar_console_init();
+#endif
+
+#if (RADAR_LOW_POWER_ENABLE == 1)
+    /* Set up the wake-up sources for tickless idle */
+    radar_low_power_init();
+#endif
+
+#if (RADAR_PROFILER_ENABLE == 1)
+    /* Start the DWT cycle counter used for profiling */
+    radar_profiler_init();
+#endif
+
+    radar_boot_mark(RADAR_BOOT_CONSOLE);
+
+    /* The banner is printed by the terminal UI task, so that it does not */
+    /* delay the radar bring-up                                           */
+    radar_boot_init();
+
+    /* Initialize the event log before any task can print or mute it */
+    radar_event_log_init();
+
+    /* Initialize the parameter command queue of the radar task and power */
+    /* up the sensors                                                    */
+    radar_task_init();
+
+    /* Initialize the flash driver for the saved settings */
+    radar_profile_init();
+
+#if (RADAR_CAPTURE_ENABLE == 1)
+    /* Initialize the frame buffers before the radar task can fill them */
+    radar_capture_init();
+#endif
 
     /* Create task that initializes context object of RadarSensing,        */
     /* initializes radar device configuration, sets parameters for         */
     /* presence detection, registers callback to handle presence detection */
     /* events and continuously processes data acquired from radar.         */
     cy_thread_t ifxradar_task;
-    result = cy_rtos_create_thread(&ifxradar_task,
-                                   radar_task,
-                                   RADAR_TASK_NAME,
-                                   NULL,
-                                   RADAR_TASK_STACK_SIZE,
-                                   RADAR_TASK_PRIORITY,
-                                   (cy_thread_arg_t)NULL);
+    result = radar_rtos_create_thread(&ifxradar_task,
+                                      radar_task,
+                                      RADAR_TASK_NAME,
+                                      RADAR_RTOS_TASK_MEMORY(ifxradar_task),
+                                      RADAR_TASK_STACK_SIZE,
+                                      RADAR_TASK_PRIORITY);
     if (result != CY_RSLT_SUCCESS)
     {
         CY_ASSERT(0);
@@ -97,17 +181,57 @@ int main(void)
     /* Create task for a terminal UI that configures parameters for presence */
     /* detection application.                                                */
     cy_thread_t ifxradar_task_terminal_ui;
-    result = cy_rtos_create_thread(&ifxradar_task_terminal_ui,
-                                   radar_presence_terminal_ui,
-                                   RADAR_PRESENCE_TERMINAL_UI_TASK_NAME,
-                                   NULL,
-                                   RADAR_PRESENCE_TERMINAL_UI_TASK_STACK_SIZE,
-                                   RADAR_PRESENCE_TERMINAL_UI_TASK_PRIORITY,
-                                   (cy_thread_arg_t)NULL);
+    result = radar_rtos_create_thread(&ifxradar_task_terminal_ui,
+                                      radar_presence_terminal_ui,
+                                      RADAR_PRESENCE_TERMINAL_UI_TASK_NAME,
+                                      RADAR_RTOS_TASK_MEMORY(ifxradar_task_terminal_ui),
+                                      RADAR_PRESENCE_TERMINAL_UI_TASK_STACK_SIZE,
+                                      RADAR_PRESENCE_TERMINAL_UI_TASK_PRIORITY);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Create task that dispatches the events published by the radar task. */
+    cy_thread_t ifxradar_task_event_bus;
+    result = radar_rtos_create_thread(&ifxradar_task_event_bus,
+                                      radar_event_bus_task,
+                                      RADAR_EVENT_BUS_TASK_NAME,
+                                      RADAR_RTOS_TASK_MEMORY(ifxradar_task_event_bus),
+                                      RADAR_EVENT_BUS_TASK_STACK_SIZE,
+                                      RADAR_EVENT_BUS_TASK_PRIORITY);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Create task that prints the events published by the radar task. */
+    cy_thread_t ifxradar_task_event_log;
+    result = radar_rtos_create_thread(&ifxradar_task_event_log,
+                                      radar_event_log_task,
+                                      RADAR_EVENT_LOG_TASK_NAME,
+                                      RADAR_RTOS_TASK_MEMORY(ifxradar_task_event_log),
+                                      RADAR_EVENT_LOG_TASK_STACK_SIZE,
+                                      RADAR_EVENT_LOG_TASK_PRIORITY);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+#if (RADAR_CAPTURE_ENABLE == 1)
+    /* Create task that streams the captured radar frames. */
+    cy_thread_t ifxradar_task_capture;
+    result = radar_rtos_create_thread(&ifxradar_task_capture,
+                                      radar_capture_task,
+                                      RADAR_CAPTURE_TASK_NAME,
+                                      RADAR_RTOS_TASK_MEMORY(ifxradar_task_capture),
+                                      RADAR_CAPTURE_TASK_STACK_SIZE,
+                                      RADAR_CAPTURE_TASK_PRIORITY);
     if (result != CY_RSLT_SUCCESS)
     {
         CY_ASSERT(0);
     }
+#endif
 
     /* Start the FreeRTOS scheduler. */
     vTaskStartScheduler();
@@ -0,0 +1,298 @@
+/*****************************************************************************
+** File name: radar_adaptive.c
+**
+** Description: This file implements the adaptive frame rate of the radar
+** presence application: after a configurable time without presence and
+** without events, the radar only runs for a short part of every cycle,
+** and it runs continuously again as soon as a target is detected.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file includes */
+#include "cy_pdl.h"
+
+/* Header file for local module */
+#include "radar_adaptive.h"
+#include "radar_time.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Written by the radar task, read by the terminal UI in a critical section */
+static radar_adaptive_config_t adaptive_config =
+{
+    .idle_s = RADAR_ADAPTIVE_DEFAULT_IDLE_S,
+    .period_ms = RADAR_ADAPTIVE_DEFAULT_PERIOD_MS,
+    .on_ms = RADAR_ADAPTIVE_DEFAULT_ON_MS
+};
+static radar_adaptive_stats_t adaptive_stats;
+static uint64_t adaptive_since_ms; /* Start of the current state */
+
+/* Radar task only */
+static bool adaptive_presence;        /* A target is present in front of a sensor */
+static uint64_t adaptive_activity_ms; /* Time of the last event or of the return to the full rate */
+static uint64_t adaptive_deadline_ms; /* End of the current low rate phase */
+
+/*******************************************************************************
+ * Function Name: radar_adaptive_enter
+ ********************************************************************************
+ * Summary:
+ *   Switches to a new state and accounts the time spent in the old one
+ *
+ * Parameters:
+ *   state: new state
+ *   now_ms: current time
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_adaptive_enter(radar_adaptive_state_t state, uint64_t now_ms)
+{
+    uint64_t elapsed_ms = now_ms - adaptive_since_ms;
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+
+    if (adaptive_stats.state != RADAR_ADAPTIVE_FULL)
+    {
+        adaptive_stats.low_ms += elapsed_ms;
+    }
+    if (adaptive_stats.state == RADAR_ADAPTIVE_LOW_OFF)
+    {
+        adaptive_stats.off_ms += elapsed_ms;
+    }
+    if ((adaptive_stats.state == RADAR_ADAPTIVE_FULL) && (state != RADAR_ADAPTIVE_FULL))
+    {
+        adaptive_stats.low_count++;
+    }
+    adaptive_stats.state = state;
+    adaptive_since_ms = now_ms;
+
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_adaptive_init
+ ********************************************************************************
+ * Summary:
+ *   Starts at the full rate. Called by the radar task once the radar is
+ *   running.
+ *
+ * Parameters:
+ *   now_ms: current time
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_adaptive_init(uint64_t now_ms)
+{
+    adaptive_stats.state = RADAR_ADAPTIVE_FULL;
+    adaptive_since_ms = now_ms;
+    adaptive_activity_ms = now_ms;
+    adaptive_presence = false;
+}
+
+/*******************************************************************************
+ * Function Name: radar_adaptive_set_config
+ ********************************************************************************
+ * Summary:
+ *   Changes the policy. A new cycle takes effect with the next low rate
+ *   phase. Must only be called by the radar task.
+ *
+ * Parameters:
+ *   config: new policy
+ *
+ * Return:
+ *   false if the policy is out of the limits and has not been changed
+ *******************************************************************************/
+bool radar_adaptive_set_config(const radar_adaptive_config_t *config)
+{
+    if (config->idle_s > RADAR_ADAPTIVE_MAX_IDLE_S)
+    {
+        return false;
+    }
+    if ((config->idle_s != 0U) &&
+        ((config->on_ms < RADAR_ADAPTIVE_MIN_ON_MS) || (config->on_ms >= config->period_ms) ||
+         (config->period_ms > RADAR_ADAPTIVE_MAX_PERIOD_MS)))
+    {
+        return false;
+    }
+
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    adaptive_config = *config;
+    Cy_SysLib_ExitCriticalSection(status);
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: radar_adaptive_get_config
+ ********************************************************************************
+ * Summary:
+ *   Reads the policy
+ *
+ * Parameters:
+ *   config: policy
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_adaptive_get_config(radar_adaptive_config_t *config)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    *config = adaptive_config;
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_adaptive_activity
+ ********************************************************************************
+ * Summary:
+ *   Records a presence event. Restarts the idle time and, if a target is
+ *   present, makes the next radar_adaptive_update() return to the full
+ *   rate. Must only be called by the radar task.
+ *
+ * Parameters:
+ *   presence: a target is present in front of any sensor
+ *   now_ms: time of the event
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_adaptive_activity(bool presence, uint64_t now_ms)
+{
+    adaptive_presence = presence;
+    adaptive_activity_ms = now_ms;
+}
+
+/*******************************************************************************
+ * Function Name: radar_adaptive_update
+ ********************************************************************************
+ * Summary:
+ *   Advances the policy to the current time. Must only be called by the
+ *   radar task, after every frame and whenever it wakes up without a frame.
+ *
+ * Parameters:
+ *   now_ms: current time
+ *   wait_ms: returns the time until the next change of state is due
+ *
+ * Return:
+ *   true if the state has changed, see radar_adaptive_get_state()
+ *******************************************************************************/
+bool radar_adaptive_update(uint64_t now_ms, uint32_t *wait_ms)
+{
+    radar_adaptive_state_t state = adaptive_stats.state;
+    uint64_t idle_ms = (uint64_t)adaptive_config.idle_s * 1000U;
+    uint64_t wait = UINT32_MAX;
+
+    if (state == RADAR_ADAPTIVE_FULL)
+    {
+        if ((idle_ms != 0U) && !adaptive_presence)
+        {
+            uint64_t quiet_ms = now_ms - adaptive_activity_ms;
+            if (quiet_ms >= idle_ms)
+            {
+                /* The radar has just been running, start with the pause */
+                state = RADAR_ADAPTIVE_LOW_OFF;
+                adaptive_deadline_ms = now_ms + adaptive_config.period_ms - adaptive_config.on_ms;
+            }
+            else
+            {
+                wait = idle_ms - quiet_ms;
+            }
+        }
+    }
+    else if ((idle_ms == 0U) || adaptive_presence)
+    {
+        state = RADAR_ADAPTIVE_FULL;
+        adaptive_activity_ms = now_ms;
+    }
+    else if (now_ms >= adaptive_deadline_ms)
+    {
+        if (state == RADAR_ADAPTIVE_LOW_ON)
+        {
+            state = RADAR_ADAPTIVE_LOW_OFF;
+            adaptive_deadline_ms = now_ms + adaptive_config.period_ms - adaptive_config.on_ms;
+        }
+        else
+        {
+            state = RADAR_ADAPTIVE_LOW_ON;
+            adaptive_deadline_ms = now_ms + adaptive_config.on_ms;
+        }
+    }
+
+    if (state != RADAR_ADAPTIVE_FULL)
+    {
+        wait = adaptive_deadline_ms - now_ms;
+    }
+    *wait_ms = (uint32_t)((wait < UINT32_MAX) ? wait : UINT32_MAX);
+
+    if (state == adaptive_stats.state)
+    {
+        return false;
+    }
+    radar_adaptive_enter(state, now_ms);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: radar_adaptive_get_state
+ ********************************************************************************
+ * Summary:
+ *   Returns the current state
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   state
+ *******************************************************************************/
+radar_adaptive_state_t radar_adaptive_get_state(void)
+{
+    return adaptive_stats.state;
+}
+
+/*******************************************************************************
+ * Function Name: radar_adaptive_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Reads the current state and the time spent at the low rate
+ *
+ * Parameters:
+ *   stats: statistics
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_adaptive_get_stats(radar_adaptive_stats_t *stats)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    *stats = adaptive_stats;
+    uint64_t elapsed_ms = radar_time_ms() - adaptive_since_ms;
+    Cy_SysLib_ExitCriticalSection(status);
+
+    if (stats->state != RADAR_ADAPTIVE_FULL)
+    {
+        stats->low_ms += elapsed_ms;
+    }
+    if (stats->state == RADAR_ADAPTIVE_LOW_OFF)
+    {
+        stats->off_ms += elapsed_ms;
+    }
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+** File name: radar_adaptive.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_adaptive.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Policy at startup: adaptive frame rate off */
+#define RADAR_ADAPTIVE_DEFAULT_IDLE_S (0U)
+#define RADAR_ADAPTIVE_DEFAULT_PERIOD_MS (2000U)
+#define RADAR_ADAPTIVE_DEFAULT_ON_MS (500U)
+
+/* Limits of the policy. The radar must run long enough per cycle for the
+   presence detection to see a target, and the cycle bounds the reaction
+   time at the low rate. */
+#define RADAR_ADAPTIVE_MAX_IDLE_S (3600U)
+#define RADAR_ADAPTIVE_MIN_ON_MS (200U)
+#define RADAR_ADAPTIVE_MAX_PERIOD_MS (10000U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef enum
+{
+    RADAR_ADAPTIVE_FULL,    /* Radar running continuously */
+    RADAR_ADAPTIVE_LOW_ON,  /* Low rate, radar running for on_ms */
+    RADAR_ADAPTIVE_LOW_OFF  /* Low rate, radar stopped for the rest of the cycle */
+} radar_adaptive_state_t;
+
+typedef struct
+{
+    uint32_t idle_s;    /* Time without presence and events before the low rate, 0 = always full rate */
+    uint32_t period_ms; /* Cycle of the low rate, bounds the reaction time */
+    uint32_t on_ms;     /* Part of the cycle with the radar running */
+} radar_adaptive_config_t;
+
+typedef struct
+{
+    radar_adaptive_state_t state;
+    uint32_t low_count;  /* Number of switches to the low rate */
+    uint64_t low_ms;     /* Time spent at the low rate, including the current period */
+    uint64_t off_ms;     /* Time the radar was stopped, including the current period */
+} radar_adaptive_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void radar_adaptive_init(uint64_t now_ms);
+bool radar_adaptive_set_config(const radar_adaptive_config_t *config);
+void radar_adaptive_get_config(radar_adaptive_config_t *config);
+void radar_adaptive_activity(bool presence, uint64_t now_ms);
+bool radar_adaptive_update(uint64_t now_ms, uint32_t *wait_ms);
+radar_adaptive_state_t radar_adaptive_get_state(void);
+void radar_adaptive_get_stats(radar_adaptive_stats_t *stats);
@@ -0,0 +1,170 @@
+/*****************************************************************************
+** File name: radar_boot.c
+**
+** Description: This file implements the boot-phase timestamps of the radar
+** presence application. Each startup step is timed once against the
+** microsecond clock and the table is printed on the console after the first
+** frame.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file from system */
+#include <inttypes.h>
+#include <stdio.h>
+
+/* Header file includes */
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_boot.h"
+#include "radar_rtos.h"
+#include "radar_time.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Time at the end of every phase in us, valid once the phase is marked. Each
+   phase is marked by a single task, so a flag per phase needs no lock. */
+static uint32_t boot_time_us[RADAR_BOOT_PHASES];
+static volatile bool boot_marked[RADAR_BOOT_PHASES];
+
+/* Given once the first frame has been processed */
+static SemaphoreHandle_t boot_done;
+#if (RADAR_STATIC_MEMORY_ENABLE == 1)
+static StaticSemaphore_t boot_done_storage;
+#endif
+
+static const char *const boot_phase_names[RADAR_BOOT_PHASES] =
+{
+    [RADAR_BOOT_CONSOLE] = "Console",
+    [RADAR_BOOT_RADAR_POWER] = "Radar power",
+    [RADAR_BOOT_SCHEDULER] = "Scheduler",
+    [RADAR_BOOT_SPI] = "SPI",
+    [RADAR_BOOT_SENSING] = "Sensing init",
+    [RADAR_BOOT_PARAMETERS] = "Parameters",
+    [RADAR_BOOT_ENABLE] = "Enable",
+    [RADAR_BOOT_FIRST_FRAME] = "First frame",
+    [RADAR_BOOT_MENU] = "Menu",
+    [RADAR_BOOT_FIRST_EVENT] = "First event"
+};
+
+/*******************************************************************************
+ * Function Name: radar_boot_init
+ ********************************************************************************
+ * Summary:
+ *   Creates the semaphore signalling the first frame. Must be called before
+ *   the scheduler is started.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_boot_init(void)
+{
+    if (radar_rtos_init_binary_semaphore(&boot_done, RADAR_RTOS_OBJECT_MEMORY(boot_done)) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_boot_mark
+ ********************************************************************************
+ * Summary:
+ *   Records the end of a boot phase. Only the first call for a phase counts,
+ *   so the per-frame marks cost a flag test once the phase is done.
+ *
+ * Parameters:
+ *   phase: phase that has ended
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_boot_mark(radar_boot_phase_t phase)
+{
+    if (boot_marked[phase])
+    {
+        return;
+    }
+
+    boot_time_us[phase] = (uint32_t)radar_time_us();
+    boot_marked[phase] = true;
+
+    if ((phase == RADAR_BOOT_FIRST_FRAME) && (boot_done != NULL))
+    {
+        xSemaphoreGive(boot_done);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_boot_wait
+ ********************************************************************************
+ * Summary:
+ *   Waits until the first frame has been processed
+ *
+ * Parameters:
+ *   timeout: longest time to wait
+ *
+ * Return:
+ *   true if the first frame has been processed
+ *******************************************************************************/
+bool radar_boot_wait(TickType_t timeout)
+{
+    return boot_marked[RADAR_BOOT_FIRST_FRAME] || (xSemaphoreTake(boot_done, timeout) == pdTRUE);
+}
+
+/*******************************************************************************
+ * Function Name: radar_boot_print
+ ********************************************************************************
+ * Summary:
+ *   Prints the end of every boot phase in ms since the BSP initialization,
+ *   and the time since the previous phase.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_boot_print(void)
+{
+    uint32_t previous_us = 0U;
+
+    printf("Boot phases (ms since BSP init):\n");
+    for (uint32_t i = 0; i < (uint32_t)RADAR_BOOT_PHASES; i++)
+    {
+        if (!boot_marked[i])
+        {
+            printf("  %-12s        -\n", boot_phase_names[i]);
+            continue;
+        }
+
+        uint32_t time_us = boot_time_us[i];
+        uint32_t delta_us = (time_us > previous_us) ? (time_us - previous_us) : 0U;
+        printf("  %-12s %4" PRIu32 ".%03" PRIu32 " (+%" PRIu32 ".%03" PRIu32 ")\n",
+               boot_phase_names[i],
+               time_us / 1000U, time_us % 1000U,
+               delta_us / 1000U, delta_us % 1000U);
+        previous_us = time_us;
+    }
+}
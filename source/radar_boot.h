@@ -0,0 +1,68 @@
+/******************************************************************************
+** File name: radar_boot.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_boot.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Longest time the terminal UI waits for the first frame before it prints
+   the boot phases */
+#define RADAR_BOOT_REPORT_TIMEOUT pdMS_TO_TICKS(2000)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Startup phases, in the order they normally end. Every phase is timed from
+   the start of the microsecond clock right after the BSP initialization. */
+typedef enum
+{
+    RADAR_BOOT_CONSOLE,     /* Console UART ready */
+    RADAR_BOOT_RADAR_POWER, /* Radar LDOs on, devices held in reset */
+    RADAR_BOOT_SCHEDULER,   /* Radar task running */
+    RADAR_BOOT_SPI,         /* IRQ pins and SPI bus initialized */
+    RADAR_BOOT_SENSING,     /* mtb_radar_sensing_init() done for all sensors */
+    RADAR_BOOT_PARAMETERS,  /* Saved or default parameters set */
+    RADAR_BOOT_ENABLE,      /* Contexts enabled, the radars acquire frames */
+    RADAR_BOOT_FIRST_FRAME, /* First frame processed */
+    RADAR_BOOT_MENU,        /* Banner and menu queued for the console */
+    RADAR_BOOT_FIRST_EVENT, /* First presence event published */
+    RADAR_BOOT_PHASES
+} radar_boot_phase_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void radar_boot_init(void);
+void radar_boot_mark(radar_boot_phase_t phase);
+bool radar_boot_wait(TickType_t timeout);
+void radar_boot_print(void);
@@ -0,0 +1,478 @@
+/*****************************************************************************
+** File name: radar_capture.c
+**
+** Description: This file implements the raw frame capture. The FIFO data
+** that the radar driver reads during one mtb_radar_sensing_process() call is
+** collected in a frame buffer and streamed to the host as a binary record by
+** a low-priority task, together with the timestamp passed to the library.
+** The active parameter set is sent whenever capture starts or a parameter
+** changes.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file for local module */
+#include "radar_capture.h"
+
+#if (RADAR_CAPTURE_ENABLE == 1)
+
+/* Header file from system */
+#include <string.h>
+
+/* Header file for local module */
+#include "radar_params.h"
+#include "radar_rtos.h"
+#include "radar_stream.h"
+#include "radar_task.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Size of the fields in front of the data of a frame record */
+#define RADAR_CAPTURE_FRAME_HEADER_SIZE (11U)
+/* Flags of a frame record */
+#define RADAR_CAPTURE_FLAG_TRUNCATED (0x01U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t sequence;
+    uint32_t timestamp;
+    uint16_t dropped;
+    uint8_t flags;
+    uint32_t length;
+    uint8_t data[RADAR_CAPTURE_FRAME_SIZE];
+} radar_capture_buffer_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Buffers circulate between the two queues. The radar task takes a buffer
+   from capture_free and passes it on through capture_full, the capture task
+   returns it to capture_free once the frame has been sent. */
+static radar_capture_buffer_t capture_buffers[RADAR_CAPTURE_BUFFERS];
+static QueueHandle_t capture_free;
+static QueueHandle_t capture_full;
+#if (RADAR_STATIC_MEMORY_ENABLE == 1)
+static uint8_t capture_free_items[RADAR_CAPTURE_BUFFERS * sizeof(radar_capture_buffer_t *)];
+static StaticQueue_t capture_free_storage;
+static uint8_t capture_full_items[RADAR_CAPTURE_BUFFERS * sizeof(radar_capture_buffer_t *)];
+static StaticQueue_t capture_full_storage;
+#endif
+
+static volatile bool capture_active;
+static volatile bool capture_params_pending;
+
+/* State of the radar task */
+static radar_capture_buffer_t *capture_fill;
+static bool capture_in_frame;
+static bool capture_lost;
+static uint32_t capture_sequence;
+static uint16_t capture_pending_dropped;
+
+static radar_capture_stats_t capture_stats;
+static radar_stream_t capture_stream;
+
+/*******************************************************************************
+ * Function Name: radar_capture_init
+ ********************************************************************************
+ * Summary:
+ *   Creates the buffer queues and hands all buffers to the radar task. Must
+ *   be called before the scheduler is started.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_capture_init(void)
+{
+    if (radar_rtos_init_queue(&capture_free,
+                              RADAR_CAPTURE_BUFFERS,
+                              sizeof(radar_capture_buffer_t *),
+                              RADAR_RTOS_QUEUE_MEMORY(capture_free)) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (radar_rtos_init_queue(&capture_full,
+                              RADAR_CAPTURE_BUFFERS,
+                              sizeof(radar_capture_buffer_t *),
+                              RADAR_RTOS_QUEUE_MEMORY(capture_full)) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    for (uint32_t i = 0; i < RADAR_CAPTURE_BUFFERS; i++)
+    {
+        radar_capture_buffer_t *buffer = &capture_buffers[i];
+        (void)xQueueSend(capture_free, &buffer, 0);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_set_active
+ ********************************************************************************
+ * Summary:
+ *   Starts or stops the capture. Starting resets the counters and sends the
+ *   parameter set before the first frame. Frames that are already buffered
+ *   when the capture stops are still sent.
+ *
+ * Parameters:
+ *   active: true to start, false to stop
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_capture_set_active(bool active)
+{
+    if (active && !capture_active)
+    {
+        taskENTER_CRITICAL();
+        memset(&capture_stats, 0, sizeof(capture_stats));
+        taskEXIT_CRITICAL();
+        capture_params_pending = true;
+    }
+    capture_active = active;
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_is_active
+ ********************************************************************************
+ * Summary:
+ *   Tells if frames are captured.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   true while the capture runs
+ *******************************************************************************/
+bool radar_capture_is_active(void)
+{
+    return capture_active;
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Returns the frame counters since the capture was started.
+ *
+ * Parameters:
+ *   stats: snapshot of the counters
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_capture_get_stats(radar_capture_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = capture_stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_frame_begin
+ ********************************************************************************
+ * Summary:
+ *   Called by the radar task before mtb_radar_sensing_process(). Gets a free
+ *   buffer for the FIFO data read during the call.
+ *
+ * Parameters:
+ *   timestamp: time passed to mtb_radar_sensing_process() in ms
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_capture_frame_begin(uint64_t timestamp)
+{
+    if (!capture_active)
+    {
+        /* Return a buffer that was kept after the capture stopped */
+        if (capture_fill != NULL)
+        {
+            capture_fill->length = 0U;
+            (void)xQueueSend(capture_free, &capture_fill, 0);
+            capture_fill = NULL;
+        }
+        return;
+    }
+
+    if (capture_fill == NULL)
+    {
+        (void)xQueueReceive(capture_free, &capture_fill, 0);
+    }
+
+    if ((capture_fill != NULL) && (capture_fill->length == 0U))
+    {
+        capture_fill->timestamp = (uint32_t)timestamp;
+        capture_fill->flags = 0U;
+    }
+
+    capture_in_frame = true;
+    capture_lost = false;
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_spi_data
+ ********************************************************************************
+ * Summary:
+ *   Called for every completed SPI transfer of the radar driver. FIFO reads
+ *   during a frame are appended to the frame buffer.
+ *
+ * Parameters:
+ *   data: received bytes
+ *   length: number of bytes
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_capture_spi_data(const uint8_t *data, size_t length)
+{
+    if (!capture_in_frame || (length < RADAR_CAPTURE_MIN_BURST))
+    {
+        return;
+    }
+
+    if (capture_fill == NULL)
+    {
+        capture_lost = true;
+        return;
+    }
+
+    size_t space = RADAR_CAPTURE_FRAME_SIZE - capture_fill->length;
+    if (length > space)
+    {
+        length = space;
+        capture_fill->flags |= RADAR_CAPTURE_FLAG_TRUNCATED;
+    }
+
+    memcpy(&capture_fill->data[capture_fill->length], data, length);
+    capture_fill->length += length;
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_frame_end
+ ********************************************************************************
+ * Summary:
+ *   Called by the radar task after mtb_radar_sensing_process(). Passes a
+ *   buffer with FIFO data to the capture task, or counts the frame as
+ *   dropped if no buffer was free.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_capture_frame_end(void)
+{
+    if (!capture_in_frame)
+    {
+        return;
+    }
+    capture_in_frame = false;
+
+    if (capture_lost)
+    {
+        capture_sequence++;
+        if (capture_pending_dropped < UINT16_MAX)
+        {
+            capture_pending_dropped++;
+        }
+        taskENTER_CRITICAL();
+        capture_stats.dropped++;
+        taskEXIT_CRITICAL();
+        return;
+    }
+
+    if ((capture_fill == NULL) || (capture_fill->length == 0U))
+    {
+        /* No FIFO data in this call, keep the buffer for the next one */
+        return;
+    }
+
+    if ((capture_fill->flags & RADAR_CAPTURE_FLAG_TRUNCATED) != 0U)
+    {
+        taskENTER_CRITICAL();
+        capture_stats.truncated++;
+        taskEXIT_CRITICAL();
+    }
+
+    capture_fill->sequence = capture_sequence++;
+    capture_fill->dropped = capture_pending_dropped;
+    capture_pending_dropped = 0U;
+
+    (void)xQueueSend(capture_full, &capture_fill, 0);
+    capture_fill = NULL;
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_parameters_changed
+ ********************************************************************************
+ * Summary:
+ *   Requests a new parameter record before the next frame.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_capture_parameters_changed(void)
+{
+    capture_params_pending = true;
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_put_u32
+ ********************************************************************************
+ * Summary:
+ *   Stores a 32-bit value little endian.
+ *
+ * Parameters:
+ *   buffer: destination
+ *   value: value to store
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_capture_put_u32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_send_parameters
+ ********************************************************************************
+ * Summary:
+ *   Sends a RADAR_STREAM_TYPE_CAPTURE_PARAMS record: the sequence number of
+ *   the next frame (4 bytes) followed by one "key=value\n" line per
+ *   parameter.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_capture_send_parameters(void)
+{
+    radar_param_value_t values[RADAR_PARAMS];
+    char value[RADAR_PARAMS_VALUE_MAXLENGTH];
+    uint8_t sequence[4];
+
+    radar_capture_put_u32(sequence, capture_sequence);
+    radar_task_get_values(values);
+
+    /* The record must not be interleaved with event output */
+    radar_presence_task_set_mute(true);
+    radar_stream_begin(&capture_stream, RADAR_STREAM_TYPE_CAPTURE_PARAMS);
+    radar_stream_write(&capture_stream, sequence, sizeof(sequence));
+    for (uint32_t i = 0; i < (uint32_t)RADAR_PARAMS; i++)
+    {
+        const char *key = radar_params_get_info((radar_param_id_t)i)->key;
+        radar_params_format((radar_param_id_t)i, values[i], value, sizeof(value));
+        radar_stream_write(&capture_stream, key, strlen(key));
+        radar_stream_write(&capture_stream, "=", 1U);
+        radar_stream_write(&capture_stream, value, strlen(value));
+        radar_stream_write(&capture_stream, "\n", 1U);
+    }
+    radar_stream_end(&capture_stream);
+    radar_presence_task_set_mute(false);
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_send_frame
+ ********************************************************************************
+ * Summary:
+ *   Sends a RADAR_STREAM_TYPE_CAPTURE_FRAME record. All fields are little
+ *   endian: sequence number (4 bytes), timestamp in ms (4 bytes), frames
+ *   dropped right before this one (2 bytes), flags (1 byte), followed by
+ *   the FIFO data as read from the radar.
+ *
+ * Parameters:
+ *   buffer: frame buffer
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_capture_send_frame(const radar_capture_buffer_t *buffer)
+{
+    uint8_t header[RADAR_CAPTURE_FRAME_HEADER_SIZE];
+
+    radar_capture_put_u32(&header[0], buffer->sequence);
+    radar_capture_put_u32(&header[4], buffer->timestamp);
+    header[8] = (uint8_t)buffer->dropped;
+    header[9] = (uint8_t)(buffer->dropped >> 8);
+    header[10] = buffer->flags;
+
+    radar_presence_task_set_mute(true);
+    radar_stream_begin(&capture_stream, RADAR_STREAM_TYPE_CAPTURE_FRAME);
+    radar_stream_write(&capture_stream, header, sizeof(header));
+    radar_stream_write(&capture_stream, buffer->data, buffer->length);
+    radar_stream_end(&capture_stream);
+    radar_presence_task_set_mute(false);
+}
+
+/*******************************************************************************
+ * Function Name: radar_capture_task
+ ********************************************************************************
+ * Summary:
+ *   Streams the captured frames to the host.
+ *
+ * Parameters:
+ *   arg: thread
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_capture_task(cy_thread_arg_t arg)
+{
+    radar_capture_buffer_t *buffer;
+
+    for (;;)
+    {
+        (void)xQueueReceive(capture_full, &buffer, portMAX_DELAY);
+
+        if (capture_params_pending)
+        {
+            capture_params_pending = false;
+            radar_capture_send_parameters();
+        }
+
+        radar_capture_send_frame(buffer);
+
+        taskENTER_CRITICAL();
+        capture_stats.frames++;
+        taskEXIT_CRITICAL();
+
+        buffer->length = 0U;
+        (void)xQueueSend(capture_free, &buffer, 0);
+    }
+}
+
+#endif /* RADAR_CAPTURE_ENABLE */
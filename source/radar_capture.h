@@ -0,0 +1,87 @@
+/******************************************************************************
+** File name: radar_capture.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_capture.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Raw frame capture, selected with RADAR_CAPTURE in the Makefile */
+#ifndef RADAR_CAPTURE_ENABLE
+#define RADAR_CAPTURE_ENABLE (0)
+#endif
+
+/* Name of the capture task */
+#define RADAR_CAPTURE_TASK_NAME "RADAR CAPTURE"
+/* Stack size for the capture task */
+#define RADAR_CAPTURE_TASK_STACK_SIZE (2048)
+/* Priority number for the capture task */
+#ifndef RADAR_CAPTURE_TASK_PRIORITY
+#define RADAR_CAPTURE_TASK_PRIORITY (CY_RTOS_PRIORITY_LOW)
+#endif
+/* Console baud rate of a build with frame capture */
+#define RADAR_CAPTURE_BAUDRATE (921600UL)
+/* Largest frame that is captured, longer frames are truncated */
+#define RADAR_CAPTURE_FRAME_SIZE (8192U)
+/* SPI reads of at least this many bytes are FIFO data, shorter ones are
+   register accesses and not captured */
+#define RADAR_CAPTURE_MIN_BURST (64U)
+/* Number of frame buffers: one is filled by the radar task while the other
+   is streamed by the capture task */
+#define RADAR_CAPTURE_BUFFERS (2U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t frames;    /* Frames streamed to the host */
+    uint32_t dropped;   /* Frames lost because no buffer was free */
+    uint32_t truncated; /* Frames longer than RADAR_CAPTURE_FRAME_SIZE */
+} radar_capture_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+#if (RADAR_CAPTURE_ENABLE == 1)
+void radar_capture_init(void);
+void radar_capture_set_active(bool active);
+bool radar_capture_is_active(void);
+void radar_capture_get_stats(radar_capture_stats_t *stats);
+void radar_capture_frame_begin(uint64_t timestamp);
+void radar_capture_spi_data(const uint8_t *data, size_t length);
+void radar_capture_frame_end(void);
+void radar_capture_parameters_changed(void);
+void radar_capture_task(cy_thread_arg_t arg);
+#endif
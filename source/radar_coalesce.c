@@ -0,0 +1,222 @@
+/*****************************************************************************
+** File name: radar_coalesce.c
+**
+** Description: This file implements the coalescing of the presence events
+** of the radar presence application. A presence out event is held back for
+** the hold time: if the target is detected again within it, both events are
+** dropped, otherwise the presence out event is published late with the number
+** of events that were dropped before it.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file includes */
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_coalesce.h"
+#include "radar_task.h"
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Presence out event held back for one sensor */
+typedef struct
+{
+    radar_event_record_t record; /* Held event */
+    uint16_t coalesced;          /* Events dropped since the last published one */
+    bool pending;                /* A presence out event is held */
+} radar_coalesce_sensor_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Written by the terminal UI task, read by the radar task */
+static volatile uint32_t coalesce_hold_ms;
+
+/* Radar task only, read by the terminal UI for the statistics */
+static radar_coalesce_sensor_t coalesce_sensors[RADAR_SENSOR_COUNT];
+static radar_coalesce_stats_t coalesce_stats;
+
+/*******************************************************************************
+ * Function Name: radar_coalesce_set_hold
+ ********************************************************************************
+ * Summary:
+ *   Sets the hold time of the presence out events. An event that is held
+ *   when the coalescing is turned off is published with the next frame.
+ *
+ * Parameters:
+ *   hold_ms: hold time, 0 for off
+ *
+ * Return:
+ *   true if the hold time is within the limit
+ *******************************************************************************/
+bool radar_coalesce_set_hold(uint32_t hold_ms)
+{
+    if (hold_ms > RADAR_COALESCE_MAX_HOLD_MS)
+    {
+        return false;
+    }
+
+    coalesce_hold_ms = hold_ms;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: radar_coalesce_get_hold
+ ********************************************************************************
+ * Summary:
+ *   Returns the hold time of the presence out events
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   hold time in ms, 0 if the coalescing is off
+ *******************************************************************************/
+uint32_t radar_coalesce_get_hold(void)
+{
+    return coalesce_hold_ms;
+}
+
+/*******************************************************************************
+ * Function Name: radar_coalesce_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Copies the number of raw and coalesced presence events
+ *
+ * Parameters:
+ *   stats: receives the statistics
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_coalesce_get_stats(radar_coalesce_stats_t *stats)
+{
+    *stats = coalesce_stats;
+}
+
+/*******************************************************************************
+ * Function Name: radar_coalesce_flush
+ ********************************************************************************
+ * Summary:
+ *   Publishes the held presence out event of a sensor. Its latency is not
+ *   traced, as it includes the hold time.
+ *
+ * Parameters:
+ *   sensor: held event of the sensor
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_coalesce_flush(radar_coalesce_sensor_t *sensor)
+{
+    sensor->record.coalesced = sensor->coalesced;
+#if (RADAR_LATENCY_ENABLE == 1)
+    sensor->record.trace = RADAR_LATENCY_NO_TRACE;
+#endif
+    radar_event_bus_publish(&sensor->record);
+
+    sensor->coalesced = 0U;
+    sensor->pending = false;
+}
+
+/*******************************************************************************
+ * Function Name: radar_coalesce_filter
+ ********************************************************************************
+ * Summary:
+ *   Decides whether a presence event of the sensing callback is published
+ *   right away. A presence out event is held back, and a presence in event
+ *   within the hold time drops both. Events of other types and all events
+ *   with the coalescing off pass unchanged.
+ *
+ * Parameters:
+ *   record: event of the frame being processed
+ *
+ * Return:
+ *   true if the event is to be published now
+ *******************************************************************************/
+bool radar_coalesce_filter(radar_event_record_t *record)
+{
+    if ((record->event != RADAR_EVENT_PRESENCE_IN) && (record->event != RADAR_EVENT_PRESENCE_OUT))
+    {
+        return true;
+    }
+
+    radar_coalesce_sensor_t *sensor = &coalesce_sensors[record->sensor];
+    uint64_t hold_us = (uint64_t)coalesce_hold_ms * 1000U;
+
+    coalesce_stats.raw++;
+    if (sensor->pending && ((record->timestamp_us - sensor->record.timestamp_us) >= hold_us))
+    {
+        radar_coalesce_flush(sensor);
+    }
+
+    if (record->event == RADAR_EVENT_PRESENCE_OUT)
+    {
+        if (hold_us == 0U)
+        {
+            return true;
+        }
+        sensor->record = *record;
+        sensor->pending = true;
+        return false;
+    }
+
+    if (sensor->pending)
+    {
+        /* The target came back: the held out event and this in event cancel */
+        sensor->pending = false;
+        if (sensor->coalesced <= (UINT16_MAX - 2U))
+        {
+            sensor->coalesced += 2U;
+        }
+        coalesce_stats.coalesced += 2U;
+        return false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: radar_coalesce_poll
+ ********************************************************************************
+ * Summary:
+ *   Publishes the held presence out events whose hold time has passed.
+ *   Called by the radar task before every frame is processed.
+ *
+ * Parameters:
+ *   time_us: time of the frame
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_coalesce_poll(uint64_t time_us)
+{
+    uint64_t hold_us = (uint64_t)coalesce_hold_ms * 1000U;
+
+    for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
+    {
+        radar_coalesce_sensor_t *sensor = &coalesce_sensors[i];
+        if (sensor->pending && ((time_us - sensor->record.timestamp_us) >= hold_us))
+        {
+            radar_coalesce_flush(sensor);
+        }
+    }
+}
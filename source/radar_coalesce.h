@@ -0,0 +1,57 @@
+/******************************************************************************
+** File name: radar_coalesce.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_coalesce.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Header file for local module */
+#include "radar_event_bus.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Longest hold time of a presence out event, 0 turns the coalescing off */
+#define RADAR_COALESCE_MAX_HOLD_MS (10000U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t raw;       /* Presence events reported by the library */
+    uint32_t coalesced; /* Presence events that were not published */
+} radar_coalesce_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+bool radar_coalesce_set_hold(uint32_t hold_ms);
+uint32_t radar_coalesce_get_hold(void);
+void radar_coalesce_get_stats(radar_coalesce_stats_t *stats);
+bool radar_coalesce_filter(radar_event_record_t *record);
+void radar_coalesce_poll(uint64_t time_us);
@@ -0,0 +1,420 @@
+/*****************************************************************************
+** File name: radar_console.c
+**
+** Description: This file implements interrupt-driven console transmit and
+** receive paths. retarget-io and the terminal UI use cyhal_uart_putc() and
+** cyhal_uart_getc(), which the linker redirects to the __wrap_ functions
+** below. Transmitted characters are queued in a ring buffer that the UART
+** interrupt drains, received characters are collected in a ring buffer by the
+** UART interrupt, which wakes up the reading task.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file for local module */
+#include "radar_console.h"
+
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1) || (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+
+/* Header file includes */
+#include "cy_retarget_io.h"
+#include "cyabs_rtos.h"
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_latency.h"
+#include "radar_rtos.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define RADAR_CONSOLE_TX_RING_MASK (RADAR_CONSOLE_TX_RING_SIZE - 1U)
+
+#define RADAR_CONSOLE_RX_RING_MASK (RADAR_CONSOLE_RX_RING_SIZE - 1U)
+
+#if ((RADAR_CONSOLE_TX_RING_SIZE & RADAR_CONSOLE_TX_RING_MASK) != 0U)
+#error "RADAR_CONSOLE_TX_RING_SIZE must be a power of two"
+#endif
+
+#if ((RADAR_CONSOLE_RX_RING_SIZE & RADAR_CONSOLE_RX_RING_MASK) != 0U)
+#error "RADAR_CONSOLE_RX_RING_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1)
+/* Ring indices run freely and are only masked on access. tx_head is written
+   by the writers inside a critical section, tx_tail by the UART interrupt.
+   tx_inflight bytes from tx_tail on have been handed to the UART driver. */
+static uint8_t tx_ring[RADAR_CONSOLE_TX_RING_SIZE];
+static volatile uint32_t tx_head;
+static volatile uint32_t tx_tail;
+static volatile uint32_t tx_inflight;
+
+/* Given by the UART interrupt whenever space has been freed in the ring */
+static SemaphoreHandle_t tx_space;
+#if (RADAR_STATIC_MEMORY_ENABLE == 1)
+static StaticSemaphore_t tx_space_storage;
+#endif
+
+/* Original cyhal_uart_putc(), see --wrap in the Makefile */
+cy_rslt_t __real_cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value);
+#endif
+
+#if (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+/* rx_head is written by the UART interrupt only, rx_tail by the reading task
+   only. The reading task is woken up with a direct-to-task notification. */
+static uint8_t rx_ring[RADAR_CONSOLE_RX_RING_SIZE];
+static volatile uint32_t rx_head;
+static volatile uint32_t rx_tail;
+static TaskHandle_t volatile rx_reader;
+
+/* Original cyhal_uart_getc(), see --wrap in the Makefile */
+cy_rslt_t __real_cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout);
+#endif
+
+static bool console_ready;
+static radar_console_stats_t console_stats;
+
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: radar_console_tx_start
+ ********************************************************************************
+ * Summary:
+ *   Hands the next contiguous block of the ring to the UART driver, unless a
+ *   block is still being transmitted. Must be called from a critical section
+ *   or from the UART interrupt.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_console_tx_start(void)
+{
+    uint32_t level = tx_head - tx_tail;
+
+    if ((tx_inflight != 0U) || (level == 0U))
+    {
+        return;
+    }
+
+    uint32_t offset = tx_tail & RADAR_CONSOLE_TX_RING_MASK;
+    uint32_t length = RADAR_CONSOLE_TX_RING_SIZE - offset;
+    if (length > level)
+    {
+        length = level;
+    }
+
+    if (cyhal_uart_write_async(&cy_retarget_io_uart_obj, &tx_ring[offset], length) == CY_RSLT_SUCCESS)
+    {
+        tx_inflight = length;
+    }
+}
+#endif
+
+#if (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: radar_console_rx_drain
+ ********************************************************************************
+ * Summary:
+ *   Moves all characters from the UART receive FIFO into the ring. Characters
+ *   that do not fit are counted as lost. Must only be called from the UART
+ *   interrupt.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_console_rx_drain(void)
+{
+    uint8_t value;
+
+    while (cyhal_uart_readable(&cy_retarget_io_uart_obj) > 0U)
+    {
+        if (__real_cyhal_uart_getc(&cy_retarget_io_uart_obj, &value, 1U) != CY_RSLT_SUCCESS)
+        {
+            break;
+        }
+
+        uint32_t head = rx_head;
+        if ((head - rx_tail) >= RADAR_CONSOLE_RX_RING_SIZE)
+        {
+            console_stats.rx_lost++;
+            continue;
+        }
+        rx_ring[head & RADAR_CONSOLE_RX_RING_MASK] = value;
+        /* Publish the character before the new head becomes visible */
+        __DMB();
+        rx_head = head + 1U;
+    }
+}
+#endif
+
+/*******************************************************************************
+ * Function Name: radar_console_event_handler
+ ********************************************************************************
+ * Summary:
+ *   UART event handler. Releases the transmitted block, starts the next one
+ *   and wakes up a writer that waits for space.
+ *
+ * Parameters:
+ *   callback_arg: not used
+ *   event: UART event
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_console_event_handler(void *callback_arg, cyhal_uart_event_t event)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1)
+    if ((event & CYHAL_UART_IRQ_TX_TRANSMIT_IN_FIFO) != 0U)
+    {
+        /* The block is in the hardware FIFO, its ring space can be reused */
+        tx_tail += tx_inflight;
+        tx_inflight = 0U;
+#if (RADAR_LATENCY_ENABLE == 1)
+        radar_latency_tx_progress(tx_tail);
+#endif
+        radar_console_tx_start();
+        (void)xSemaphoreGiveFromISR(tx_space, &higher_priority_task_woken);
+    }
+#endif
+
+#if (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+    if ((event & CYHAL_UART_IRQ_RX_NOT_EMPTY) != 0U)
+    {
+        radar_console_rx_drain();
+        if ((rx_head != rx_tail) && (rx_reader != NULL))
+        {
+            vTaskNotifyGiveFromISR(rx_reader, &higher_priority_task_woken);
+        }
+    }
+#endif
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************
+ * Function Name: radar_console_init
+ ********************************************************************************
+ * Summary:
+ *   Enables the console rings. Must be called after cy_retarget_io_init().
+ *   Until the scheduler is started, characters are still written directly.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_console_init(void)
+{
+    cyhal_uart_event_t events = CYHAL_UART_IRQ_NONE;
+
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1)
+    if (radar_rtos_init_binary_semaphore(&tx_space, RADAR_RTOS_OBJECT_MEMORY(tx_space)) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    events = (cyhal_uart_event_t)(events | CYHAL_UART_IRQ_TX_TRANSMIT_IN_FIFO);
+#endif
+#if (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+    events = (cyhal_uart_event_t)(events | CYHAL_UART_IRQ_RX_NOT_EMPTY);
+#endif
+
+    cyhal_uart_register_callback(&cy_retarget_io_uart_obj, radar_console_event_handler, NULL);
+    cyhal_uart_enable_event(&cy_retarget_io_uart_obj, events, RADAR_CONSOLE_IRQ_PRIORITY, true);
+
+    console_ready = true;
+}
+
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: __wrap_cyhal_uart_putc
+ ********************************************************************************
+ * Summary:
+ *   Replaces cyhal_uart_putc() for the whole application. Characters for the
+ *   console UART are queued in the ring and the call returns at once. Only
+ *   if the ring is full, the caller sleeps until the UART interrupt has made
+ *   space. Must not be called from an interrupt.
+ *
+ * Parameters:
+ *   obj: UART block
+ *   value: character to transmit
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS
+ *******************************************************************************/
+cy_rslt_t __wrap_cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value)
+{
+    /* Critical sections keep interrupts masked until the scheduler runs */
+    if ((obj != &cy_retarget_io_uart_obj) || !console_ready ||
+        (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED))
+    {
+        return __real_cyhal_uart_putc(obj, value);
+    }
+
+    bool waited = false;
+
+    for (;;)
+    {
+        taskENTER_CRITICAL();
+        uint32_t level = tx_head - tx_tail;
+        if (level < RADAR_CONSOLE_TX_RING_SIZE)
+        {
+            tx_ring[tx_head & RADAR_CONSOLE_TX_RING_MASK] = (uint8_t)value;
+            tx_head++;
+            if (level >= console_stats.tx_max_level)
+            {
+                console_stats.tx_max_level = level + 1U;
+            }
+            radar_console_tx_start();
+            taskEXIT_CRITICAL();
+            return CY_RSLT_SUCCESS;
+        }
+        taskEXIT_CRITICAL();
+
+        if (!waited)
+        {
+            console_stats.tx_full++;
+            waited = true;
+        }
+        /* The timeout covers a give that happened before the take */
+        (void)xSemaphoreTake(tx_space, 1U);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_console_tx_pending
+ ********************************************************************************
+ * Summary:
+ *   Tells if characters are still waiting in the ring or being transmitted.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   true if the console has not finished transmitting
+ *******************************************************************************/
+bool radar_console_tx_pending(void)
+{
+    return (tx_head != tx_tail) || cyhal_uart_is_tx_active(&cy_retarget_io_uart_obj);
+}
+
+/*******************************************************************************
+ * Function Name: radar_console_tx_position
+ ********************************************************************************
+ * Summary:
+ *   Returns the number of characters queued in the ring since start-up,
+ *   which wraps around. The UART interrupt reports the same position once
+ *   these characters have been moved to the UART FIFO.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   ring position after the last queued character
+ *******************************************************************************/
+uint32_t radar_console_tx_position(void)
+{
+    return tx_head;
+}
+#endif
+
+#if (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: __wrap_cyhal_uart_getc
+ ********************************************************************************
+ * Summary:
+ *   Replaces cyhal_uart_getc() for the whole application. Characters of the
+ *   console UART are taken from the ring. While the ring is empty the caller
+ *   sleeps until the UART interrupt notifies it, so an idle reader uses no
+ *   CPU time. Only one task may read the console.
+ *
+ * Parameters:
+ *   obj: UART block
+ *   value: received character
+ *   timeout: longest time to wait in ms, 0 waits forever
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS if a character was received, CY_RTOS_TIMEOUT otherwise
+ *******************************************************************************/
+cy_rslt_t __wrap_cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout)
+{
+    if ((obj != &cy_retarget_io_uart_obj) || !console_ready ||
+        (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED))
+    {
+        return __real_cyhal_uart_getc(obj, value, timeout);
+    }
+
+    TickType_t wait_ticks = (timeout == 0U) ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+
+    rx_reader = xTaskGetCurrentTaskHandle();
+
+    for (;;)
+    {
+        uint32_t tail = rx_tail;
+        if (tail != rx_head)
+        {
+            /* Read the character before handing its slot back */
+            __DMB();
+            *value = rx_ring[tail & RADAR_CONSOLE_RX_RING_MASK];
+            __DMB();
+            rx_tail = tail + 1U;
+            return CY_RSLT_SUCCESS;
+        }
+
+        /* A notification given after the check above is not lost, the
+           wait then returns at once */
+        if (ulTaskNotifyTake(pdTRUE, wait_ticks) == 0U)
+        {
+            return CY_RTOS_TIMEOUT;
+        }
+    }
+}
+#endif
+
+/*******************************************************************************
+ * Function Name: radar_console_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Returns the highest fill level of the transmit ring, the number of writes
+ *   that found it full and the number of received characters that were lost.
+ *
+ * Parameters:
+ *   stats: snapshot of the counters
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_console_get_stats(radar_console_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = console_stats;
+    taskEXIT_CRITICAL();
+}
+
+#endif /* RADAR_CONSOLE_TX_RING_ENABLE || RADAR_CONSOLE_RX_RING_ENABLE */
@@ -0,0 +1,77 @@
+/******************************************************************************
+** File name: radar_console.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_console.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Interrupt-driven console transmit through a ring buffer, selected with
+   RADAR_CONSOLE_TX_RING in the Makefile. On by default as in the Makefile,
+   the link step must then wrap cyhal_uart_putc(). */
+#ifndef RADAR_CONSOLE_TX_RING_ENABLE
+#define RADAR_CONSOLE_TX_RING_ENABLE (1)
+#endif
+
+/* Interrupt-driven console receive through a ring buffer, selected with
+   RADAR_CONSOLE_RX_RING in the Makefile. On by default as in the Makefile,
+   the link step must then wrap cyhal_uart_getc(). */
+#ifndef RADAR_CONSOLE_RX_RING_ENABLE
+#define RADAR_CONSOLE_RX_RING_ENABLE (1)
+#endif
+
+/* Size of the transmit ring in bytes, must be a power of two */
+#define RADAR_CONSOLE_TX_RING_SIZE (2048U)
+/* Size of the receive ring in bytes, must be a power of two */
+#define RADAR_CONSOLE_RX_RING_SIZE (64U)
+/* Interrupt priority of the console UART events */
+#define RADAR_CONSOLE_IRQ_PRIORITY (CYHAL_ISR_PRIORITY_DEFAULT)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t tx_max_level; /* Highest number of bytes waiting in the ring */
+    uint32_t tx_full;      /* Writes that had to wait for space in the ring */
+    uint32_t rx_lost;      /* Received characters lost because the ring was full */
+} radar_console_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1) || (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+void radar_console_init(void);
+void radar_console_get_stats(radar_console_stats_t *stats);
+#endif
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1)
+bool radar_console_tx_pending(void);
+uint32_t radar_console_tx_position(void);
+#endif
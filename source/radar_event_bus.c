@@ -0,0 +1,336 @@
+/*****************************************************************************
+** File name: radar_event_bus.c
+**
+** Description: This file implements the event bus of the radar presence
+** application. The radar task publishes every event once into a ring, at a
+** cost that does not depend on the number of subscribers, and wakes up the
+** dispatcher task. Each subscriber reads the events in place through its own
+** cursor and has its own queue depth: deferred subscribers are called by the
+** dispatcher task, task subscribers are woken up and read from their own task.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file includes */
+#include "cy_pdl.h"
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_event_bus.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define RADAR_EVENT_BUS_MASK (RADAR_EVENT_BUS_SIZE - 1U)
+
+#if ((RADAR_EVENT_BUS_SIZE & RADAR_EVENT_BUS_MASK) != 0U)
+#error "RADAR_EVENT_BUS_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    radar_event_record_t record;
+    /* Events of each type published up to and including this one, lets a
+       subscriber count the events it skipped by type */
+    uint32_t published[RADAR_EVENT_TYPES];
+} radar_event_bus_slot_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* The head runs freely and is only masked on access. It is written by the
+   publisher (radar task) only. A slot is overwritten RADAR_EVENT_BUS_SIZE
+   events after it has been published, a subscriber never lags more than
+   half of that behind. */
+static radar_event_bus_slot_t bus_ring[RADAR_EVENT_BUS_SIZE];
+static volatile uint32_t bus_head;
+static uint32_t bus_published[RADAR_EVENT_TYPES];
+
+/* Subscribers are added before the scheduler starts, the list is constant
+   afterwards */
+static radar_event_bus_subscriber_t *bus_subscribers;
+static TaskHandle_t bus_task_handle;
+
+/*******************************************************************************
+ * Function Name: radar_event_bus_subscribe
+ ********************************************************************************
+ * Summary:
+ *   Adds a subscriber. Must be called before the scheduler is started. A
+ *   subscriber with a handler is called by the dispatcher task for every
+ *   event. A subscriber without a handler reads the events from its own task
+ *   with radar_event_bus_wait() and radar_event_bus_receive().
+ *
+ * Parameters:
+ *   subscriber: subscriber, must stay valid
+ *   name: name shown in the statistics
+ *   depth: number of events that may wait for the subscriber, older events
+ *          are skipped and counted as dropped
+ *   handler: deferred handler, or NULL for a task subscriber
+ *   arg: argument of the handler
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_bus_subscribe(radar_event_bus_subscriber_t *subscriber, const char *name, uint32_t depth,
+                               radar_event_bus_handler_t handler, void *arg)
+{
+    CY_ASSERT((depth > 0U) && (depth <= (RADAR_EVENT_BUS_SIZE / 2U)));
+
+    *subscriber = (radar_event_bus_subscriber_t)
+    {
+        .name = name,
+        .depth = depth,
+        .handler = handler,
+        .arg = arg,
+        .cursor = bus_head
+    };
+
+    /* Append, so subscribers are served in the order they subscribed */
+    radar_event_bus_subscriber_t **link = &bus_subscribers;
+    while (*link != NULL)
+    {
+        link = &(*link)->next;
+    }
+    *link = subscriber;
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_bus_publish
+ ********************************************************************************
+ * Summary:
+ *   Publishes an event. Must only be called by the radar task. Does not block
+ *   and does not depend on the number of subscribers: the event is copied
+ *   once into the ring and the dispatcher task is woken up.
+ *
+ * Parameters:
+ *   record: event
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_bus_publish(const radar_event_record_t *record)
+{
+    uint32_t head = bus_head;
+    radar_event_bus_slot_t *slot = &bus_ring[head & RADAR_EVENT_BUS_MASK];
+
+    if (record->event < RADAR_EVENT_TYPES)
+    {
+        bus_published[record->event]++;
+    }
+    slot->record = *record;
+    for (uint32_t i = 0; i < RADAR_EVENT_TYPES; i++)
+    {
+        slot->published[i] = bus_published[i];
+    }
+    /* Publish the event before the new head becomes visible */
+    __DMB();
+    bus_head = head + 1U;
+
+    if (bus_task_handle != NULL)
+    {
+        xTaskNotifyGive(bus_task_handle);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_bus_receive
+ ********************************************************************************
+ * Summary:
+ *   Returns the next event of a subscriber without copying it. If more than
+ *   depth events are waiting, the oldest ones are skipped. The event stays
+ *   valid until radar_event_bus_release(), which must follow before the
+ *   subscriber falls RADAR_EVENT_BUS_SIZE / 2 events further behind.
+ *
+ * Parameters:
+ *   subscriber: subscriber
+ *   record: next event
+ *   dropped: events skipped right before this one, by type
+ *
+ * Return:
+ *   true if an event was available
+ *******************************************************************************/
+bool radar_event_bus_receive(radar_event_bus_subscriber_t *subscriber, const radar_event_record_t **record,
+                             radar_event_bus_dropped_t *dropped)
+{
+    uint32_t head = bus_head;
+    uint32_t lag = head - subscriber->cursor;
+
+    if (lag == 0U)
+    {
+        return false;
+    }
+    /* Read the slot only after the head that published it */
+    __DMB();
+
+    if (lag > subscriber->stats.max_lag)
+    {
+        subscriber->stats.max_lag = lag;
+    }
+    if (lag > subscriber->depth)
+    {
+        subscriber->cursor = head - subscriber->depth;
+    }
+
+    const radar_event_bus_slot_t *slot = &bus_ring[subscriber->cursor & RADAR_EVENT_BUS_MASK];
+    for (uint32_t i = 0; i < RADAR_EVENT_TYPES; i++)
+    {
+        uint32_t own = (slot->record.event == i) ? 1U : 0U;
+        dropped->count[i] = slot->published[i] - subscriber->seen[i] - own;
+        subscriber->seen[i] = slot->published[i];
+        subscriber->stats.dropped[i] += dropped->count[i];
+    }
+    subscriber->stats.received++;
+    *record = &slot->record;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_bus_release
+ ********************************************************************************
+ * Summary:
+ *   Hands the event returned by radar_event_bus_receive() back
+ *
+ * Parameters:
+ *   subscriber: subscriber
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_bus_release(radar_event_bus_subscriber_t *subscriber)
+{
+    subscriber->cursor++;
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_bus_wait
+ ********************************************************************************
+ * Summary:
+ *   Blocks the task of a task subscriber until events are published or the
+ *   timeout has passed. Returns at once if events are already waiting.
+ *
+ * Parameters:
+ *   subscriber: task subscriber
+ *   timeout: longest time to wait in ticks
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_bus_wait(radar_event_bus_subscriber_t *subscriber, TickType_t timeout)
+{
+    subscriber->task = xTaskGetCurrentTaskHandle();
+
+    /* A notification given after the check is not lost, the wait then
+       returns at once */
+    if (subscriber->cursor == bus_head)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, timeout);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_bus_get_subscriber
+ ********************************************************************************
+ * Summary:
+ *   Returns a subscriber by its position in the list
+ *
+ * Parameters:
+ *   index: position, starting at 0
+ *
+ * Return:
+ *   subscriber, or NULL if there are fewer subscribers
+ *******************************************************************************/
+const radar_event_bus_subscriber_t *radar_event_bus_get_subscriber(uint32_t index)
+{
+    const radar_event_bus_subscriber_t *subscriber = bus_subscribers;
+
+    while ((subscriber != NULL) && (index-- > 0U))
+    {
+        subscriber = subscriber->next;
+    }
+
+    return subscriber;
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_bus_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Returns the counters of a subscriber
+ *
+ * Parameters:
+ *   subscriber: subscriber
+ *   stats: snapshot of the counters
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_bus_get_stats(const radar_event_bus_subscriber_t *subscriber, radar_event_bus_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = subscriber->stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_bus_task
+ ********************************************************************************
+ * Summary:
+ *   Dispatcher task. Calls the deferred subscribers for every new event and
+ *   wakes up the task subscribers that have events waiting.
+ *
+ * Parameters:
+ *   arg: thread
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_bus_task(cy_thread_arg_t arg)
+{
+    const radar_event_record_t *record;
+    radar_event_bus_dropped_t dropped;
+
+    bus_task_handle = xTaskGetCurrentTaskHandle();
+
+    for (;;)
+    {
+        for (radar_event_bus_subscriber_t *subscriber = bus_subscribers; subscriber != NULL;
+             subscriber = subscriber->next)
+        {
+            if (subscriber->handler != NULL)
+            {
+                while (radar_event_bus_receive(subscriber, &record, &dropped))
+                {
+                    subscriber->handler(record, &dropped, subscriber->arg);
+                    radar_event_bus_release(subscriber);
+                }
+            }
+            else if ((subscriber->task != NULL) && (subscriber->cursor != bus_head))
+            {
+                xTaskNotifyGive(subscriber->task);
+            }
+        }
+
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
@@ -0,0 +1,151 @@
+/******************************************************************************
+** File name: radar_event_bus.h
+**
+** Description: This file contains the function prototypes, types and
+**   constants used in radar_event_bus.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+
+/* Header file for local module */
+#include "radar_latency.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Name of the dispatcher task */
+#define RADAR_EVENT_BUS_TASK_NAME "RADAR EVENT BUS"
+/* Stack size for the dispatcher task */
+#define RADAR_EVENT_BUS_TASK_STACK_SIZE (1024)
+/* Priority number for the dispatcher task, below the radar task so that
+   publishing an event does not preempt the processing of the frame. The
+   deferred handlers such as the LEDs run when the radar task waits for the
+   next frame. */
+#ifndef RADAR_EVENT_BUS_TASK_PRIORITY
+#define RADAR_EVENT_BUS_TASK_PRIORITY (CY_RTOS_PRIORITY_BELOWNORMAL)
+#endif
+/* Number of events in the ring, must be a power of two. The depth of a
+   subscriber can be at most half of it. */
+#define RADAR_EVENT_BUS_SIZE (128U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef enum
+{
+    RADAR_EVENT_PRESENCE_IN,
+    RADAR_EVENT_PRESENCE_OUT,
+    RADAR_EVENT_RATE_LOW,  /* Adaptive frame rate switched to the low rate */
+    RADAR_EVENT_RATE_FULL, /* Adaptive frame rate switched back to the full rate */
+    RADAR_EVENT_COUNTER_IN,       /* Entrance counter: a target has entered */
+    RADAR_EVENT_COUNTER_OUT,      /* Entrance counter: a target has left */
+    RADAR_EVENT_COUNTER_OCCUPIED, /* Entrance counter: the room is occupied */
+    RADAR_EVENT_COUNTER_FREE,     /* Entrance counter: the room is free */
+    RADAR_EVENT_TELEMETRY,        /* Summary of a telemetry interval */
+    RADAR_EVENT_LOAD,             /* CPU load of a window of the load meter */
+    RADAR_EVENT_TYPES
+} radar_event_type_t;
+
+/* Event published by the radar task, read in place by the subscribers */
+typedef struct
+{
+    uint64_t timestamp_us; /* Time of the frame with the event in us */
+    union
+    {
+        struct
+        {
+            float distance;    /* Distance of the target in m (PRESENCE_IN, last one for TELEMETRY) */
+            float accuracy;    /* Accuracy of the distance in m (PRESENCE_IN, TELEMETRY) */
+        };
+        struct
+        {
+            uint32_t in_count;  /* Targets that have entered (COUNTER events only) */
+            uint32_t out_count; /* Targets that have left (COUNTER events only) */
+        };
+        struct
+        {
+            uint16_t load_permille;   /* Share of the time the CPU was not idle (LOAD only) */
+            uint16_t sleep_permille;  /* Share of the time asleep (LOAD only) */
+            uint32_t frame_active_us; /* Time the CPU was not idle per frame (LOAD only) */
+        };
+    };
+    uint8_t event;         /* radar_event_type_t */
+    uint8_t sensor;        /* Index of the sensor that detected the event */
+    uint8_t occupancy;     /* Share of the frames with presence in % (TELEMETRY only) */
+    uint16_t coalesced;    /* Presence events dropped right before this one (PRESENCE_OUT only) */
+#if (RADAR_LATENCY_ENABLE == 1)
+    uint8_t trace;         /* Latency trace ID */
+#endif
+} radar_event_record_t;
+
+/* Events of each type lost by a subscriber right before the current one */
+typedef struct
+{
+    uint32_t count[RADAR_EVENT_TYPES];
+} radar_event_bus_dropped_t;
+
+/* Handler of a deferred subscriber, called by the dispatcher task */
+typedef void (*radar_event_bus_handler_t)(const radar_event_record_t *record,
+                                          const radar_event_bus_dropped_t *dropped,
+                                          void *arg);
+
+typedef struct
+{
+    uint32_t received;                  /* Events handed to the subscriber */
+    uint32_t dropped[RADAR_EVENT_TYPES]; /* Events skipped because the subscriber lagged behind */
+    uint32_t max_lag;                   /* Highest number of events waiting for the subscriber */
+} radar_event_bus_stats_t;
+
+/* Subscriber, allocated by its owner. All fields are private to the bus. */
+typedef struct radar_event_bus_subscriber
+{
+    const char *name;
+    uint32_t depth;
+    radar_event_bus_handler_t handler;
+    void *arg;
+    TaskHandle_t volatile task;
+    uint32_t cursor;
+    uint32_t seen[RADAR_EVENT_TYPES];
+    radar_event_bus_stats_t stats;
+    struct radar_event_bus_subscriber *next;
+} radar_event_bus_subscriber_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void radar_event_bus_subscribe(radar_event_bus_subscriber_t *subscriber, const char *name, uint32_t depth,
+                               radar_event_bus_handler_t handler, void *arg);
+void radar_event_bus_publish(const radar_event_record_t *record);
+bool radar_event_bus_receive(radar_event_bus_subscriber_t *subscriber, const radar_event_record_t **record,
+                             radar_event_bus_dropped_t *dropped);
+void radar_event_bus_release(radar_event_bus_subscriber_t *subscriber);
+void radar_event_bus_wait(radar_event_bus_subscriber_t *subscriber, TickType_t timeout);
+const radar_event_bus_subscriber_t *radar_event_bus_get_subscriber(uint32_t index);
+void radar_event_bus_get_stats(const radar_event_bus_subscriber_t *subscriber, radar_event_bus_stats_t *stats);
+void radar_event_bus_task(cy_thread_arg_t arg);
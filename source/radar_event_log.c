@@ -0,0 +1,531 @@
+/*****************************************************************************
+** File name: radar_event_log.c
+**
+** Description: This file implements deferred logging of radar events. The
+** event log subscribes to the event bus, and a low priority task formats and
+** prints the events, so that no UART output happens on the radar processing
+** path.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file from system */
+#include <inttypes.h>
+#include <stdio.h>
+
+/* Header file includes */
+#include "cy_retarget_io.h"
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_console.h"
+#include "radar_event_bus.h"
+#include "radar_event_log.h"
+#include "radar_latency.h"
+#include "radar_rtos.h"
+#include "radar_stream.h"
+#include "radar_task.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static SemaphoreHandle_t terminal_print_mutex;
+#if (RADAR_STATIC_MEMORY_ENABLE == 1)
+static StaticSemaphore_t terminal_print_mutex_storage;
+#endif
+
+/* Events are read from the event bus by the event log task */
+static radar_event_bus_subscriber_t event_log_subscriber;
+
+/* Events are written as binary records instead of text, see radar_stream.c */
+static volatile bool event_log_binary;
+
+/* Prompt and line the user is typing, redrawn below the text events. Only
+   accessed with terminal_print_mutex held. */
+static const char *event_log_prompt;
+static const char *event_log_input;
+
+/* Event codes of the binary records */
+static const uint8_t event_log_codes[RADAR_EVENT_TYPES] =
+{
+    [RADAR_EVENT_PRESENCE_IN] = RADAR_STREAM_EVENT_PRESENCE_IN,
+    [RADAR_EVENT_PRESENCE_OUT] = RADAR_STREAM_EVENT_PRESENCE_OUT,
+    [RADAR_EVENT_RATE_LOW] = RADAR_STREAM_EVENT_RATE_LOW,
+    [RADAR_EVENT_RATE_FULL] = RADAR_STREAM_EVENT_RATE_FULL,
+    [RADAR_EVENT_COUNTER_IN] = RADAR_STREAM_EVENT_COUNTER_IN,
+    [RADAR_EVENT_COUNTER_OUT] = RADAR_STREAM_EVENT_COUNTER_OUT,
+    [RADAR_EVENT_COUNTER_OCCUPIED] = RADAR_STREAM_EVENT_COUNTER_OCCUPIED,
+    [RADAR_EVENT_COUNTER_FREE] = RADAR_STREAM_EVENT_COUNTER_FREE,
+    /* Sent as records of their own type */
+    [RADAR_EVENT_TELEMETRY] = 0U,
+    [RADAR_EVENT_LOAD] = 0U
+};
+
+/*******************************************************************************
+ * Function Name: radar_event_log_saturate
+ ********************************************************************************
+ * Summary:
+ *   Limits a drop counter to the 8 bits of a binary record.
+ *
+ * Parameters:
+ *   count: drop counter
+ *
+ * Return:
+ *   count, at most 255
+ *******************************************************************************/
+static uint8_t radar_event_log_saturate(uint32_t count)
+{
+    return (count > UINT8_MAX) ? UINT8_MAX : (uint8_t)count;
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_saturate16
+ ********************************************************************************
+ * Summary:
+ *   Limits an entrance count to the 16 bits of a binary record.
+ *
+ * Parameters:
+ *   count: count
+ *
+ * Return:
+ *   count, at most UINT16_MAX
+ *******************************************************************************/
+static uint16_t radar_event_log_saturate16(uint32_t count)
+{
+    return (count > UINT16_MAX) ? UINT16_MAX : (uint16_t)count;
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_is_counter
+ ********************************************************************************
+ * Summary:
+ *   Tells whether an event comes from the entrance counter.
+ *
+ * Parameters:
+ *   event: radar_event_type_t
+ *
+ * Return:
+ *   true for the COUNTER events
+ *******************************************************************************/
+static bool radar_event_log_is_counter(uint8_t event)
+{
+    return (event >= RADAR_EVENT_COUNTER_IN) && (event <= RADAR_EVENT_COUNTER_FREE);
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_send
+ ********************************************************************************
+ * Summary:
+ *   Writes an event record as a binary RADAR_STREAM_TYPE_EVENT record. All
+ *   fields are little endian: event code (1 byte), timestamp in us (8 bytes),
+ *   distance and accuracy in mm (2 bytes each), PRESENCE_IN and PRESENCE_OUT
+ *   events dropped before this one (1 byte each), sensor index (1 byte).
+ *   COUNTER events carry the in and out counts instead of distance and
+ *   accuracy.
+ *
+ * Parameters:
+ *   record: event record
+ *   dropped: events dropped right before this one
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_event_log_send(const radar_event_record_t *record, const radar_event_bus_dropped_t *dropped)
+{
+    uint8_t payload[RADAR_STREAM_EVENT_SIZE];
+    uint16_t distance;
+    uint16_t accuracy;
+
+    if (radar_event_log_is_counter(record->event))
+    {
+        distance = radar_event_log_saturate16(record->in_count);
+        accuracy = radar_event_log_saturate16(record->out_count);
+    }
+    else if (record->event == RADAR_EVENT_PRESENCE_OUT)
+    {
+        distance = record->coalesced;
+        accuracy = 0U;
+    }
+    else
+    {
+        distance = (uint16_t)(record->distance * 1000.0f + 0.5f);
+        accuracy = (uint16_t)(record->accuracy * 1000.0f + 0.5f);
+    }
+
+    payload[0] = event_log_codes[record->event];
+    for (uint32_t i = 0; i < 8U; i++)
+    {
+        payload[1U + i] = (uint8_t)(record->timestamp_us >> (8U * i));
+    }
+    payload[9] = (uint8_t)distance;
+    payload[10] = (uint8_t)(distance >> 8);
+    payload[11] = (uint8_t)accuracy;
+    payload[12] = (uint8_t)(accuracy >> 8);
+    payload[13] = radar_event_log_saturate(dropped->count[RADAR_EVENT_PRESENCE_IN]);
+    payload[14] = radar_event_log_saturate(dropped->count[RADAR_EVENT_PRESENCE_OUT]);
+    payload[15] = record->sensor;
+
+    radar_stream_send(RADAR_STREAM_TYPE_EVENT, payload, sizeof(payload));
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_send_telemetry
+ ********************************************************************************
+ * Summary:
+ *   Writes a telemetry record as a binary RADAR_STREAM_TYPE_TELEMETRY record.
+ *   All fields are little endian: end of the interval in us (8 bytes),
+ *   sensor index (1 byte), share of the frames with presence in % (1 byte),
+ *   distance and accuracy in mm of the last presence in event, 0 if the
+ *   interval had no presence (2 bytes each).
+ *
+ * Parameters:
+ *   record: telemetry record
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_event_log_send_telemetry(const radar_event_record_t *record)
+{
+    uint8_t payload[RADAR_STREAM_TELEMETRY_SIZE];
+    uint16_t distance = (uint16_t)(record->distance * 1000.0f + 0.5f);
+    uint16_t accuracy = (uint16_t)(record->accuracy * 1000.0f + 0.5f);
+
+    for (uint32_t i = 0; i < 8U; i++)
+    {
+        payload[i] = (uint8_t)(record->timestamp_us >> (8U * i));
+    }
+    payload[8] = record->sensor;
+    payload[9] = record->occupancy;
+    payload[10] = (uint8_t)distance;
+    payload[11] = (uint8_t)(distance >> 8);
+    payload[12] = (uint8_t)accuracy;
+    payload[13] = (uint8_t)(accuracy >> 8);
+
+    radar_stream_send(RADAR_STREAM_TYPE_TELEMETRY, payload, sizeof(payload));
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_send_load
+ ********************************************************************************
+ * Summary:
+ *   Writes a load meter record as a binary RADAR_STREAM_TYPE_LOAD record. All
+ *   fields are little endian: end of the window in us (8 bytes), CPU load
+ *   and sleep residency in 0.1 % (2 bytes each), active time per frame in us
+ *   (4 bytes).
+ *
+ * Parameters:
+ *   record: load meter record
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_event_log_send_load(const radar_event_record_t *record)
+{
+    uint8_t payload[RADAR_STREAM_LOAD_SIZE];
+
+    for (uint32_t i = 0; i < 8U; i++)
+    {
+        payload[i] = (uint8_t)(record->timestamp_us >> (8U * i));
+    }
+    payload[8] = (uint8_t)record->load_permille;
+    payload[9] = (uint8_t)(record->load_permille >> 8);
+    payload[10] = (uint8_t)record->sleep_permille;
+    payload[11] = (uint8_t)(record->sleep_permille >> 8);
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        payload[12U + i] = (uint8_t)(record->frame_active_us >> (8U * i));
+    }
+
+    radar_stream_send(RADAR_STREAM_TYPE_LOAD, payload, sizeof(payload));
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_print
+ ********************************************************************************
+ * Summary:
+ *   Formats and prints an event record on the console, or writes it as a
+ *   binary record in binary mode.
+ *
+ * Parameters:
+ *   record: event record
+ *   dropped: events dropped right before this one
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_event_log_print(const radar_event_record_t *record, const radar_event_bus_dropped_t *dropped)
+{
+    /* Seconds and microseconds, printed as integers to keep the full
+       resolution of long uptimes */
+    uint32_t seconds = (uint32_t)(record->timestamp_us / 1000000U);
+    uint32_t micros = (uint32_t)(record->timestamp_us % 1000000U);
+
+    if (event_log_binary)
+    {
+        switch (record->event)
+        {
+            case RADAR_EVENT_TELEMETRY:
+                radar_event_log_send_telemetry(record);
+                break;
+            case RADAR_EVENT_LOAD:
+                radar_event_log_send_load(record);
+                break;
+            default:
+                radar_event_log_send(record, dropped);
+                break;
+        }
+        return;
+    }
+
+    uint32_t dropped_in = dropped->count[RADAR_EVENT_PRESENCE_IN];
+    uint32_t dropped_out = dropped->count[RADAR_EVENT_PRESENCE_OUT];
+    if ((dropped_in != 0U) || (dropped_out != 0U))
+    {
+        printf("%" PRIu32 " events dropped (%" PRIu32 " IN, %" PRIu32 " OUT)\n",
+               dropped_in + dropped_out,
+               dropped_in,
+               dropped_out);
+    }
+
+    printf("%" PRIu32 ".%06" PRIu32 ": ", seconds, micros);
+#if (RADAR_SENSOR_COUNT > 1)
+    if ((record->event == RADAR_EVENT_PRESENCE_IN) || (record->event == RADAR_EVENT_PRESENCE_OUT) ||
+        radar_event_log_is_counter(record->event) || (record->event == RADAR_EVENT_TELEMETRY))
+    {
+        printf("[%u] ", (unsigned int)record->sensor);
+    }
+#endif
+
+    switch (record->event)
+    {
+        case RADAR_EVENT_PRESENCE_IN:
+            printf("Presence IN %.2f-%.2f\n",
+                   record->distance - record->accuracy,
+                   record->distance + record->accuracy);
+            break;
+        case RADAR_EVENT_PRESENCE_OUT:
+            if (record->coalesced != 0U)
+            {
+                printf("Presence OUT, %u events coalesced\n", (unsigned int)record->coalesced);
+            }
+            else
+            {
+                printf("Presence OUT\n");
+            }
+            break;
+        case RADAR_EVENT_RATE_LOW:
+            printf("Low frame rate\n");
+            break;
+        case RADAR_EVENT_RATE_FULL:
+            printf("Full frame rate\n");
+            break;
+        case RADAR_EVENT_COUNTER_IN:
+        case RADAR_EVENT_COUNTER_OUT:
+            printf("Counter %s, in %" PRIu32 " out %" PRIu32 "\n",
+                   (record->event == RADAR_EVENT_COUNTER_IN) ? "IN" : "OUT",
+                   record->in_count,
+                   record->out_count);
+            break;
+        case RADAR_EVENT_COUNTER_OCCUPIED:
+            printf("Room occupied\n");
+            break;
+        case RADAR_EVENT_COUNTER_FREE:
+            printf("Room free\n");
+            break;
+        case RADAR_EVENT_LOAD:
+            printf("Load: CPU %u.%u%%, asleep %u.%u%%, %" PRIu32 " us per frame\n",
+                   (unsigned int)(record->load_permille / 10U),
+                   (unsigned int)(record->load_permille % 10U),
+                   (unsigned int)(record->sleep_permille / 10U),
+                   (unsigned int)(record->sleep_permille % 10U),
+                   record->frame_active_us);
+            break;
+        case RADAR_EVENT_TELEMETRY:
+            printf("Telemetry: occupancy %u%%, last distance %.2f+-%.2f\n",
+                   (unsigned int)record->occupancy,
+                   record->distance,
+                   record->accuracy);
+            break;
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_init
+ ********************************************************************************
+ * Summary:
+ *   Initializes the mutex for terminal print and subscribes the event log to
+ *   the event bus. Must be called before the scheduler is started.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_log_init(void)
+{
+    if (radar_rtos_init_mutex(&terminal_print_mutex, RADAR_RTOS_OBJECT_MEMORY(terminal_print_mutex)) !=
+        CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    radar_event_bus_subscribe(&event_log_subscriber, "event log", RADAR_EVENT_LOG_DEPTH, NULL, NULL);
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_set_mute
+ ********************************************************************************
+ * Summary:
+ *   Temporarily disables event output, see radar_presence_task_set_mute.
+ *
+ * Parameters:
+ *   mute: true if muted
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_log_set_mute(bool mute)
+{
+    if (mute)
+    {
+        (void)xSemaphoreTakeRecursive(terminal_print_mutex, portMAX_DELAY);
+        return;
+    }
+    (void)xSemaphoreGiveRecursive(terminal_print_mutex);
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_set_input
+ ********************************************************************************
+ * Summary:
+ *   Registers the line the user is typing. Text events erase it before they
+ *   are printed and draw the prompt and the line again below them, so the
+ *   events keep flowing while the user types. Must be called with the
+ *   console muted.
+ *
+ * Parameters:
+ *   prompt: prompt in front of the line
+ *   line: line being typed, NULL once the input is done
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_log_set_input(const char *prompt, const char *line)
+{
+    event_log_prompt = prompt;
+    event_log_input = line;
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_set_binary
+ ********************************************************************************
+ * Summary:
+ *   Selects text or binary event output. Takes effect with the next event.
+ *
+ * Parameters:
+ *   binary: true for binary records, false for text lines
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_log_set_binary(bool binary)
+{
+    event_log_binary = binary;
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_is_binary
+ ********************************************************************************
+ * Summary:
+ *   Tells if events are written as binary records.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   true in binary mode
+ *******************************************************************************/
+bool radar_event_log_is_binary(void)
+{
+    return event_log_binary;
+}
+
+/*******************************************************************************
+ * Function Name: radar_event_log_task
+ ********************************************************************************
+ * Summary:
+ *   Waits for events on the event bus and prints them. While the console is
+ *   muted the events wait on the bus and are flushed as soon as the mute is
+ *   released. A line the user is typing is drawn again below the events.
+ *
+ * Parameters:
+ *   arg: thread
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_event_log_task(cy_thread_arg_t arg)
+{
+    const radar_event_record_t *record;
+    radar_event_bus_dropped_t dropped;
+
+    for (;;)
+    {
+        radar_event_bus_wait(&event_log_subscriber, portMAX_DELAY);
+
+        /* Blocks while the console is muted */
+        (void)xSemaphoreTakeRecursive(terminal_print_mutex, portMAX_DELAY);
+        /* Keep binary records behind text that is still buffered */
+        (void)fflush(stdout);
+        bool erased = false;
+        while (radar_event_bus_receive(&event_log_subscriber, &record, &dropped))
+        {
+            if ((event_log_input != NULL) && !event_log_binary && !erased)
+            {
+                /* ANSI ESC sequence to clear the line being typed */
+                printf("\r\x1b[K");
+                erased = true;
+            }
+#if (RADAR_LATENCY_ENABLE == 1)
+            uint8_t trace = record->trace;
+            radar_latency_event_mark(trace, RADAR_LATENCY_DEQUEUE);
+#endif
+            radar_event_log_print(record, &dropped);
+            radar_event_bus_release(&event_log_subscriber);
+#if (RADAR_LATENCY_ENABLE == 1)
+            /* The trace ends when the event has reached the UART */
+            (void)fflush(stdout);
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1)
+            radar_latency_output_at(trace, radar_console_tx_position());
+#else
+            radar_latency_output(trace);
+#endif
+#endif
+        }
+        if (erased)
+        {
+            printf("%s%s", event_log_prompt, event_log_input);
+            (void)fflush(stdout);
+        }
+        (void)xSemaphoreGiveRecursive(terminal_print_mutex);
+    }
+}
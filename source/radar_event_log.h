@@ -0,0 +1,58 @@
+/******************************************************************************
+** File name: radar_event_log.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_event_log.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Name of the event log task */
+#define RADAR_EVENT_LOG_TASK_NAME "RADAR EVENT LOG"
+/* Stack size for the event log task */
+#define RADAR_EVENT_LOG_TASK_STACK_SIZE (2048)
+/* Priority number for the event log task */
+#ifndef RADAR_EVENT_LOG_TASK_PRIORITY
+#define RADAR_EVENT_LOG_TASK_PRIORITY (CY_RTOS_PRIORITY_LOW)
+#endif
+/* Number of events that may wait on the event bus for the event log. Events
+   are buffered while the console is muted. */
+#define RADAR_EVENT_LOG_DEPTH (64U)
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void radar_event_log_init(void);
+void radar_event_log_set_mute(bool mute);
+void radar_event_log_set_input(const char *prompt, const char *line);
+void radar_event_log_set_binary(bool binary);
+bool radar_event_log_is_binary(void);
+void radar_event_log_task(cy_thread_arg_t arg);
@@ -0,0 +1,516 @@
+/*****************************************************************************
+** File name: radar_latency.c
+**
+** Description: This file traces the latency of every presence event, from
+** the radar IRQ edge through processing, event bus and LED write to the
+** UART, and reports the p50/p99/max of every trace point over the last
+** events. All times are taken from the microsecond clock of radar_time.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file for local module */
+#include "radar_latency.h"
+
+#if (RADAR_LATENCY_ENABLE == 1)
+
+/* Header file from system */
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Header file includes */
+#include "cy_pdl.h"
+
+/* Header file for local module */
+#include "radar_task.h"
+#include "radar_time.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* A trace is complete when all trace points have been stamped */
+#define RADAR_LATENCY_COMPLETE ((1UL << RADAR_LATENCY_STAGES) - 1U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint64_t irq_us;                          /* Time of the IRQ edge */
+    uint32_t delta_us[RADAR_LATENCY_STAGES]; /* Trace points after irq_us */
+    uint32_t stamped;                         /* Bit mask of the stamped points */
+    uint32_t tx_position;                     /* Console position of the output end */
+    bool tx_wait;                             /* Waiting for the UART to reach tx_position */
+    uint8_t trace;                            /* Trace ID using the slot */
+    bool used;
+} radar_latency_slot_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Written by the radar IRQs, taken by the radar task at the frame start. One
+   bit of latency_irq_pending per sensor. */
+static volatile uint64_t latency_irq_us[RADAR_SENSOR_COUNT];
+static volatile uint32_t latency_irq_pending;
+
+/* Trace of the frame being processed, radar task only */
+static radar_latency_slot_t latency_frame;
+static uint8_t latency_frame_first;
+
+/* Events in flight. The slot of a trace ID is trace % RADAR_LATENCY_PENDING,
+   a slot whose ID does not match has been reused for a newer event. */
+static radar_latency_slot_t latency_slots[RADAR_LATENCY_PENDING];
+static uint8_t latency_next_trace;
+static uint32_t latency_tx_sent;
+
+/* Completed traces */
+static uint32_t latency_samples[RADAR_LATENCY_SAMPLES][RADAR_LATENCY_STAGES];
+static uint32_t latency_sample_count;
+static uint32_t latency_overwritten;
+
+/* Sort buffer of radar_latency_print(), terminal UI task only */
+static uint32_t latency_sorted[RADAR_LATENCY_SAMPLES];
+
+static const char *const latency_stage_names[RADAR_LATENCY_STAGES] =
+{
+    "process start",
+    "callback",
+    "publish",
+    "LED write",
+    "process end",
+    "dequeue",
+    "UART FIFO"
+};
+
+/*******************************************************************************
+ * Function Name: radar_latency_stamp
+ ********************************************************************************
+ * Summary:
+ *   Stamps a trace point of a trace with the current time
+ *
+ * Parameters:
+ *   slot: trace
+ *   stage: trace point
+ *   now_us: current time
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_latency_stamp(radar_latency_slot_t *slot, radar_latency_stage_t stage, uint64_t now_us)
+{
+    slot->delta_us[stage] = (uint32_t)(now_us - slot->irq_us);
+    slot->stamped |= (1UL << stage);
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_complete
+ ********************************************************************************
+ * Summary:
+ *   Moves a trace with all trace points stamped to the samples and frees its
+ *   slot. Must be called from a critical section.
+ *
+ * Parameters:
+ *   slot: trace
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_latency_complete(radar_latency_slot_t *slot)
+{
+    if (slot->stamped != RADAR_LATENCY_COMPLETE)
+    {
+        return;
+    }
+
+    memcpy(latency_samples[latency_sample_count % RADAR_LATENCY_SAMPLES], slot->delta_us, sizeof(slot->delta_us));
+    latency_sample_count++;
+    slot->used = false;
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_find
+ ********************************************************************************
+ * Summary:
+ *   Returns the slot of a trace, or NULL if the slot has been reused
+ *
+ * Parameters:
+ *   trace: trace ID
+ *
+ * Return:
+ *   slot of the trace
+ *******************************************************************************/
+static radar_latency_slot_t *radar_latency_find(uint8_t trace)
+{
+    radar_latency_slot_t *slot = &latency_slots[trace % RADAR_LATENCY_PENDING];
+
+    return ((trace != RADAR_LATENCY_NO_TRACE) && slot->used && (slot->trace == trace)) ? slot : NULL;
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_irq
+ ********************************************************************************
+ * Summary:
+ *   Records the time of a radar IRQ edge. Called by the radar IRQ handler.
+ *   The IRQ handlers of all sensors have the same priority and do not
+ *   preempt each other.
+ *
+ * Parameters:
+ *   sensor: index of the sensor that raised the IRQ
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_irq(uint32_t sensor)
+{
+    latency_irq_us[sensor] = radar_time_us();
+    latency_irq_pending |= (1UL << sensor);
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_frame_begin
+ ********************************************************************************
+ * Summary:
+ *   Starts the trace of a frame right before mtb_radar_sensing_process().
+ *   Without an IRQ edge since the last frame, which is the case for the
+ *   further frames of a burst and in polling mode, the frame is traced from
+ *   the start of processing.
+ *
+ * Parameters:
+ *   sensor: index of the sensor whose frame is processed
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_frame_begin(uint32_t sensor)
+{
+    uint64_t now_us = radar_time_us();
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+
+    uint32_t mask = 1UL << sensor;
+    latency_frame.irq_us = ((latency_irq_pending & mask) != 0U) ? latency_irq_us[sensor] : now_us;
+    latency_irq_pending &= ~mask;
+    latency_frame.stamped = 0U;
+    radar_latency_stamp(&latency_frame, RADAR_LATENCY_PROCESS_START, now_us);
+    latency_frame_first = latency_next_trace;
+
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_frame_end
+ ********************************************************************************
+ * Summary:
+ *   Stamps the end of processing into the traces of all events of the frame
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_frame_end(void)
+{
+    uint64_t now_us = radar_time_us();
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+
+    for (uint8_t trace = latency_frame_first; trace != latency_next_trace; trace++)
+    {
+        radar_latency_slot_t *slot = radar_latency_find(trace);
+        if (slot != NULL)
+        {
+            radar_latency_stamp(slot, RADAR_LATENCY_PROCESS_END, now_us);
+            radar_latency_complete(slot);
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_mark
+ ********************************************************************************
+ * Summary:
+ *   Stamps a trace point of the frame being processed. Called by the radar
+ *   task from the sensing callback.
+ *
+ * Parameters:
+ *   stage: trace point
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_mark(radar_latency_stage_t stage)
+{
+    radar_latency_stamp(&latency_frame, stage, radar_time_us());
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_publish
+ ********************************************************************************
+ * Summary:
+ *   Starts the trace of an event from the trace points of its frame and
+ *   stamps the publish time. Called by the radar task right before the event
+ *   is published on the event bus. The oldest trace in flight is dropped if
+ *   all slots are in use.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   trace ID, to be passed along with the event
+ *******************************************************************************/
+uint8_t radar_latency_publish(void)
+{
+    uint64_t now_us = radar_time_us();
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    if (latency_next_trace == RADAR_LATENCY_NO_TRACE)
+    {
+        latency_next_trace++;
+    }
+    uint8_t trace = latency_next_trace++;
+    radar_latency_slot_t *slot = &latency_slots[trace % RADAR_LATENCY_PENDING];
+
+    if (slot->used)
+    {
+        latency_overwritten++;
+    }
+    *slot = latency_frame;
+    slot->trace = trace;
+    slot->tx_wait = false;
+    slot->used = true;
+    radar_latency_stamp(slot, RADAR_LATENCY_PUBLISH, now_us);
+
+    Cy_SysLib_ExitCriticalSection(status);
+
+    return trace;
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_event_mark
+ ********************************************************************************
+ * Summary:
+ *   Stamps a trace point of a published event. Called by the subscribers of
+ *   the event bus.
+ *
+ * Parameters:
+ *   trace: trace ID of the event
+ *   stage: trace point
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_event_mark(uint8_t trace, radar_latency_stage_t stage)
+{
+    uint64_t now_us = radar_time_us();
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    radar_latency_slot_t *slot = radar_latency_find(trace);
+
+    if (slot != NULL)
+    {
+        radar_latency_stamp(slot, stage, now_us);
+        radar_latency_complete(slot);
+    }
+
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_output
+ ********************************************************************************
+ * Summary:
+ *   Stamps the time the output of an event has been written to the UART
+ *   FIFO. Used when characters are written to the UART directly.
+ *
+ * Parameters:
+ *   trace: trace ID of the event
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_output(uint8_t trace)
+{
+    uint64_t now_us = radar_time_us();
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    radar_latency_slot_t *slot = radar_latency_find(trace);
+
+    if (slot != NULL)
+    {
+        radar_latency_stamp(slot, RADAR_LATENCY_OUTPUT, now_us);
+        radar_latency_complete(slot);
+    }
+
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_output_at
+ ********************************************************************************
+ * Summary:
+ *   Completes the trace of an event once the console transmit ring has
+ *   handed all characters up to the given position to the UART FIFO. Used
+ *   when the output goes through the console ring.
+ *
+ * Parameters:
+ *   trace: trace ID of the event
+ *   tx_position: ring position right after the output of the event
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_output_at(uint8_t trace, uint32_t tx_position)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    radar_latency_slot_t *slot = radar_latency_find(trace);
+
+    if (slot != NULL)
+    {
+        if ((int32_t)(latency_tx_sent - tx_position) >= 0)
+        {
+            radar_latency_stamp(slot, RADAR_LATENCY_OUTPUT, radar_time_us());
+            radar_latency_complete(slot);
+        }
+        else
+        {
+            slot->tx_position = tx_position;
+            slot->tx_wait = true;
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_tx_progress
+ ********************************************************************************
+ * Summary:
+ *   Completes the traces whose output has reached the UART FIFO. Called by
+ *   the console UART interrupt whenever a block of the transmit ring has
+ *   been moved to the FIFO.
+ *
+ * Parameters:
+ *   tx_position: ring position up to which all characters are in the FIFO
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_tx_progress(uint32_t tx_position)
+{
+    uint64_t now_us = radar_time_us();
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+
+    latency_tx_sent = tx_position;
+    for (uint32_t i = 0; i < RADAR_LATENCY_PENDING; i++)
+    {
+        radar_latency_slot_t *slot = &latency_slots[i];
+        if (slot->used && slot->tx_wait && ((int32_t)(tx_position - slot->tx_position) >= 0))
+        {
+            slot->tx_wait = false;
+            radar_latency_stamp(slot, RADAR_LATENCY_OUTPUT, now_us);
+            radar_latency_complete(slot);
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_reset
+ ********************************************************************************
+ * Summary:
+ *   Discards the completed traces
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_reset(void)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    latency_sample_count = 0U;
+    latency_overwritten = 0U;
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_latency_print
+ ********************************************************************************
+ * Summary:
+ *   Prints p50, p99 and max of every trace point over the last completed
+ *   traces
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_latency_print(void)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    uint32_t total = latency_sample_count;
+    uint32_t overwritten = latency_overwritten;
+    Cy_SysLib_ExitCriticalSection(status);
+
+    uint32_t count = (total < RADAR_LATENCY_SAMPLES) ? total : RADAR_LATENCY_SAMPLES;
+
+    printf("Latency from radar IRQ, last %" PRIu32 " of %" PRIu32 " events (%" PRIu32 " traces lost)\n",
+           count, total, overwritten);
+    if (count == 0U)
+    {
+        return;
+    }
+
+    printf("%-14s %8s %8s %8s\n", "trace point", "p50 us", "p99 us", "max us");
+    for (uint32_t stage = 0; stage < RADAR_LATENCY_STAGES; stage++)
+    {
+        /* Copy one column, a trace completed meanwhile may replace a sample */
+        status = Cy_SysLib_EnterCriticalSection();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            latency_sorted[i] = latency_samples[i][stage];
+        }
+        Cy_SysLib_ExitCriticalSection(status);
+
+        /* Insertion sort, the sample count is small */
+        for (uint32_t i = 1; i < count; i++)
+        {
+            uint32_t value = latency_sorted[i];
+            uint32_t j = i;
+            while ((j > 0U) && (latency_sorted[j - 1U] > value))
+            {
+                latency_sorted[j] = latency_sorted[j - 1U];
+                j--;
+            }
+            latency_sorted[j] = value;
+        }
+
+        printf("%-14s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 "\n",
+               latency_stage_names[stage],
+               latency_sorted[(count - 1U) / 2U],
+               latency_sorted[((count - 1U) * 99U) / 100U],
+               latency_sorted[count - 1U]);
+    }
+}
+
+#endif /* RADAR_LATENCY_ENABLE */
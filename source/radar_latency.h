@@ -0,0 +1,81 @@
+/******************************************************************************
+** File name: radar_latency.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_latency.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* IRQ-to-output latency tracing, selected with RADAR_LATENCY in the
+   Makefile */
+#ifndef RADAR_LATENCY_ENABLE
+#define RADAR_LATENCY_ENABLE (0)
+#endif
+
+/* Number of completed traces kept for the percentiles */
+#define RADAR_LATENCY_SAMPLES (128U)
+/* Number of events that can be traced at the same time, from the callback
+   until their output has reached the UART */
+#define RADAR_LATENCY_PENDING (8U)
+/* Trace ID of events that are not traced */
+#define RADAR_LATENCY_NO_TRACE (0xFFU)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Trace points of an event, in the order they are normally reached. Every
+   point is measured from the radar IRQ edge that started the frame. */
+typedef enum
+{
+    RADAR_LATENCY_PROCESS_START, /* mtb_radar_sensing_process() called */
+    RADAR_LATENCY_CALLBACK,      /* radar_sensing_callback() entered */
+    RADAR_LATENCY_PUBLISH,       /* Event published on the event bus */
+    RADAR_LATENCY_LED,           /* LED written by the LED subscriber */
+    RADAR_LATENCY_PROCESS_END,   /* mtb_radar_sensing_process() returned */
+    RADAR_LATENCY_DEQUEUE,       /* Event received by the event log task */
+    RADAR_LATENCY_OUTPUT,        /* Last byte of the event in the UART FIFO */
+    RADAR_LATENCY_STAGES
+} radar_latency_stage_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+#if (RADAR_LATENCY_ENABLE == 1)
+void radar_latency_irq(uint32_t sensor);
+void radar_latency_frame_begin(uint32_t sensor);
+void radar_latency_frame_end(void);
+void radar_latency_mark(radar_latency_stage_t stage);
+uint8_t radar_latency_publish(void);
+void radar_latency_event_mark(uint8_t trace, radar_latency_stage_t stage);
+void radar_latency_output(uint8_t trace);
+void radar_latency_output_at(uint8_t trace, uint32_t tx_position);
+void radar_latency_tx_progress(uint32_t tx_position);
+void radar_latency_reset(void);
+void radar_latency_print(void);
+#endif
@@ -0,0 +1,225 @@
+/*****************************************************************************
+** File name: radar_load.c
+**
+** Description: This file implements the CPU load meter of the radar presence
+** application. The scheduler reports every switch into and out of the idle
+** task, so the idle time is measured with the microsecond clock, sleep
+** included. The radar task closes a window every RADAR_LOAD_WINDOW_MS, which
+** gives the load, the sleep residency and the active time per frame.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file for local module */
+#include "radar_load.h"
+
+#if (RADAR_LOAD_ENABLE == 1)
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_event_bus.h"
+#include "radar_event_log.h"
+#include "radar_low_power.h"
+#include "radar_time.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Written by the scheduler with interrupts masked */
+static uint64_t load_idle_us;
+static uint64_t load_idle_start_us;
+static bool load_idle_running;
+
+/* Radar task only */
+static uint64_t load_window_start_us;
+static uint64_t load_window_idle_us;
+static uint32_t load_window_frames;
+#if (RADAR_LOW_POWER_ENABLE == 1)
+static uint64_t load_window_sleep_ms;
+#endif
+
+/* Written by the radar task, read by the terminal UI */
+static radar_load_stats_t load_stats;
+
+/*******************************************************************************
+ * Function Name: radar_load_task_switched_in
+ ********************************************************************************
+ * Summary:
+ *   Starts the idle time when the idle task is switched in. Called by the
+ *   scheduler through traceTASK_SWITCHED_IN.
+ *
+ * Parameters:
+ *   task: task that is switched in
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_load_task_switched_in(void *task)
+{
+    if (task == (void *)xTaskGetIdleTaskHandle())
+    {
+        load_idle_start_us = radar_time_us();
+        load_idle_running = true;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_load_task_switched_out
+ ********************************************************************************
+ * Summary:
+ *   Adds the idle time when the idle task is switched out. Called by the
+ *   scheduler through traceTASK_SWITCHED_OUT.
+ *
+ * Parameters:
+ *   task: task that is switched out
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_load_task_switched_out(void *task)
+{
+    (void)task;
+
+    if (load_idle_running)
+    {
+        load_idle_us += radar_time_us() - load_idle_start_us;
+        load_idle_running = false;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_load_publish
+ ********************************************************************************
+ * Summary:
+ *   Publishes the figures of a window as a RADAR_EVENT_LOAD record on the
+ *   event bus
+ *
+ * Parameters:
+ *   stats: figures of the window
+ *   time_us: end of the window
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_load_publish(const radar_load_stats_t *stats, uint64_t time_us)
+{
+    radar_event_record_t record =
+    {
+        .timestamp_us = time_us,
+        .load_permille = stats->load_permille,
+        .sleep_permille = stats->sleep_permille,
+        .frame_active_us = stats->frame_active_us,
+        .event = RADAR_EVENT_LOAD
+    };
+
+#if (RADAR_LATENCY_ENABLE == 1)
+    record.trace = RADAR_LATENCY_NO_TRACE;
+#endif
+    radar_event_bus_publish(&record);
+}
+
+/*******************************************************************************
+ * Function Name: radar_load_frame
+ ********************************************************************************
+ * Summary:
+ *   Counts a processed frame and closes the window once RADAR_LOAD_WINDOW_MS
+ *   have passed. With binary event output on, the figures of every window
+ *   are sent as a record. Called by the radar task before every frame is
+ *   processed.
+ *
+ * Parameters:
+ *   time_us: time of the frame
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_load_frame(uint64_t time_us)
+{
+    load_window_frames++;
+    if ((time_us - load_window_start_us) < ((uint64_t)RADAR_LOAD_WINDOW_MS * 1000U))
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    uint64_t idle_us = load_idle_us;
+    taskEXIT_CRITICAL();
+
+    uint64_t window_us = time_us - load_window_start_us;
+    uint64_t active_us = window_us - (idle_us - load_window_idle_us);
+    radar_load_stats_t stats =
+    {
+        .window_ms = (uint32_t)(window_us / 1000U),
+        .frames = load_window_frames,
+        .load_permille = (uint16_t)((active_us * 1000U) / window_us),
+        .sleep_permille = 0U,
+        .frame_active_us = (uint32_t)(active_us / load_window_frames)
+    };
+
+#if (RADAR_LOW_POWER_ENABLE == 1)
+    radar_low_power_stats_t power;
+    radar_low_power_get_stats(&power);
+    uint64_t sleep_ms = power.deep_sleep_ms + power.sleep_ms;
+    uint64_t window_sleep_ms = sleep_ms - load_window_sleep_ms;
+    stats.sleep_permille = (uint16_t)(((window_sleep_ms < stats.window_ms) ? window_sleep_ms : stats.window_ms) *
+                                      1000U / stats.window_ms);
+    load_window_sleep_ms = sleep_ms;
+#endif
+
+    /* The first window starts with the first frame and is not reported */
+    if (load_window_start_us != 0U)
+    {
+        uint32_t status = Cy_SysLib_EnterCriticalSection();
+        load_stats = stats;
+        Cy_SysLib_ExitCriticalSection(status);
+
+        if (radar_event_log_is_binary())
+        {
+            radar_load_publish(&stats, time_us);
+        }
+    }
+
+    load_window_start_us = time_us;
+    load_window_idle_us = idle_us;
+    load_window_frames = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: radar_load_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Copies the figures of the last complete window
+ *
+ * Parameters:
+ *   stats: receives the figures, all zero before the first window
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_load_get_stats(radar_load_stats_t *stats)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    *stats = load_stats;
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+#endif /* RADAR_LOAD_ENABLE */
@@ -0,0 +1,65 @@
+/******************************************************************************
+** File name: radar_load.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_load.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* CPU load meter, selected with RADAR_LOAD in the Makefile */
+#ifndef RADAR_LOAD_ENABLE
+#define RADAR_LOAD_ENABLE (0)
+#endif
+
+/* Length of a measurement window */
+#ifndef RADAR_LOAD_WINDOW_MS
+#define RADAR_LOAD_WINDOW_MS (1000U)
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Figures of the last complete window */
+typedef struct
+{
+    uint32_t window_ms;       /* Length of the window, longer while the radars were stopped */
+    uint32_t frames;          /* Frames processed by all sensors */
+    uint16_t load_permille;   /* Share of the time the CPU was not idle */
+    uint16_t sleep_permille;  /* Share of the time in deep sleep or CPU sleep (RADAR_LOW_POWER=1) */
+    uint32_t frame_active_us; /* Time the CPU was not idle per frame */
+} radar_load_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+#if (RADAR_LOAD_ENABLE == 1)
+void radar_load_task_switched_in(void *task);
+void radar_load_task_switched_out(void *task);
+void radar_load_frame(uint64_t time_us);
+void radar_load_get_stats(radar_load_stats_t *stats);
+#endif
@@ -0,0 +1,241 @@
+/*****************************************************************************
+** File name: radar_low_power.c
+**
+** Description: This file implements tickless idle for the radar presence
+** application. The CM4 enters deep sleep between radar frames and is woken up
+** by the radar IRQ line, the console UART RX line or the next RTOS timeout.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file for local module */
+#include "radar_low_power.h"
+
+#if (RADAR_LOW_POWER_ENABLE == 1)
+
+/* Header file includes */
+#include "cy_retarget_io.h"
+#include "cybsp.h"
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_console.h"
+#include "radar_time.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Interrupt priority of the console RX wake-up interrupt */
+#define CONSOLE_RX_WAKE_PRIORITY (CYHAL_ISR_PRIORITY_DEFAULT)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cyhal_lptimer_t sleep_timer;
+static radar_low_power_stats_t sleep_stats;
+static cyhal_syspm_callback_data_t uart_syspm_cb_data;
+static volatile bool console_hold;
+static volatile TickType_t console_rx_tick;
+
+/*******************************************************************************
+ * Function Name: uart_syspm_callback
+ ********************************************************************************
+ * Summary:
+ *   Refuses deep sleep while the console UART is still shifting out data, so
+ *   that no output is lost when the peripheral clocks are stopped.
+ *
+ * Parameters:
+ *   state: power state being entered
+ *   mode: phase of the transition
+ *   callback_arg: UART object
+ *
+ * Return:
+ *   true if the transition is allowed
+ *******************************************************************************/
+static bool uart_syspm_callback(cyhal_syspm_callback_state_t state,
+                                cyhal_syspm_callback_mode_t mode,
+                                void *callback_arg)
+{
+    if (mode == CYHAL_SYSPM_CHECK_READY)
+    {
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1)
+        /* Characters still waiting in the transmit ring count as active */
+        return !radar_console_tx_pending();
+#else
+        return !cyhal_uart_is_tx_active((cyhal_uart_t *)callback_arg);
+#endif
+    }
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: console_rx_wake_handler
+ ********************************************************************************
+ * Summary:
+ *   Interrupt handler of the console RX pin. The UART cannot receive in deep
+ *   sleep, so the first edge of a character wakes up the device and holds it
+ *   in CPU sleep until the user has been idle for
+ *   RADAR_LOW_POWER_CONSOLE_HOLD_MS.
+ *
+ * Parameters:
+ *   callback_arg: not used
+ *   event: GPIO event that triggered the interrupt
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void console_rx_wake_handler(void *callback_arg, cyhal_gpio_event_t event)
+{
+    console_rx_tick = xTaskGetTickCountFromISR();
+    if (!console_hold)
+    {
+        console_hold = true;
+        cyhal_syspm_lock_deepsleep();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_low_power_init
+ ********************************************************************************
+ * Summary:
+ *   Initializes the low power timer used to wake up from tickless idle and
+ *   registers the console wake-up sources. The radar IRQ line is a GPIO
+ *   interrupt and wakes up the device from deep sleep without further setup.
+ *   Must be called after retarget-io has been initialized.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_low_power_init(void)
+{
+    if (cyhal_lptimer_init(&sleep_timer) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    uart_syspm_cb_data.callback = uart_syspm_callback;
+    uart_syspm_cb_data.states = CYHAL_SYSPM_CB_CPU_DEEPSLEEP;
+    uart_syspm_cb_data.ignore_modes = (cyhal_syspm_callback_mode_t)0;
+    uart_syspm_cb_data.args = &cy_retarget_io_uart_obj;
+    uart_syspm_cb_data.next = NULL;
+    cyhal_syspm_register_callback(&uart_syspm_cb_data);
+
+    cyhal_gpio_register_callback(CYBSP_DEBUG_UART_RX, console_rx_wake_handler, NULL);
+    cyhal_gpio_enable_event(CYBSP_DEBUG_UART_RX, CYHAL_GPIO_IRQ_FALL, CONSOLE_RX_WAKE_PRIORITY, true);
+}
+
+/*******************************************************************************
+ * Function Name: radar_low_power_sleep
+ ********************************************************************************
+ * Summary:
+ *   Tickless idle handler, called by the FreeRTOS idle task through
+ *   portSUPPRESS_TICKS_AND_SLEEP with the scheduler suspended. Enters deep
+ *   sleep if no peripheral refuses it and CPU sleep otherwise, then steps the
+ *   tick count by the time actually spent asleep.
+ *
+ * Parameters:
+ *   expected_idle_ticks: number of ticks until the next task is due
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_low_power_sleep(TickType_t expected_idle_ticks)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+
+    if (console_hold && ((xTaskGetTickCount() - console_rx_tick) >= pdMS_TO_TICKS(RADAR_LOW_POWER_CONSOLE_HOLD_MS)))
+    {
+        console_hold = false;
+        cyhal_syspm_unlock_deepsleep();
+    }
+
+    if (eTaskConfirmSleepModeStatus() != eAbortSleep)
+    {
+        uint32_t desired_ms = expected_idle_ticks * portTICK_PERIOD_MS;
+        uint32_t actual_ms = 0;
+        bool deep_sleep = false;
+
+        if (!console_hold)
+        {
+            deep_sleep = (cyhal_syspm_tickless_deepsleep(&sleep_timer, desired_ms, &actual_ms) == CY_RSLT_SUCCESS);
+            if (!deep_sleep)
+            {
+                sleep_stats.refused_count++;
+            }
+        }
+        if (!deep_sleep)
+        {
+            actual_ms = 0;
+            if (cyhal_syspm_tickless_sleep(&sleep_timer, desired_ms, &actual_ms) != CY_RSLT_SUCCESS)
+            {
+                actual_ms = 0;
+            }
+        }
+
+        TickType_t slept_ticks = actual_ms / portTICK_PERIOD_MS;
+        if (slept_ticks > expected_idle_ticks)
+        {
+            slept_ticks = expected_idle_ticks;
+        }
+        if (slept_ticks > 0)
+        {
+            vTaskStepTick(slept_ticks);
+        }
+
+        if (deep_sleep)
+        {
+            /* The timestamp timer does not count in deep sleep */
+            radar_time_add_sleep(actual_ms);
+            sleep_stats.deep_sleep_ms += slept_ticks * portTICK_PERIOD_MS;
+            sleep_stats.deep_sleep_count++;
+        }
+        else
+        {
+            sleep_stats.sleep_ms += slept_ticks * portTICK_PERIOD_MS;
+            sleep_stats.sleep_count++;
+        }
+    }
+
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_low_power_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Returns a consistent snapshot of the sleep residency counters.
+ *
+ * Parameters:
+ *   stats: snapshot of the counters
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_low_power_get_stats(radar_low_power_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = sleep_stats;
+    taskEXIT_CRITICAL();
+    stats->uptime_ms = radar_time_ms();
+}
+
+#endif /* RADAR_LOW_POWER_ENABLE */
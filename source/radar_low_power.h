@@ -0,0 +1,79 @@
+/******************************************************************************
+** File name: radar_low_power.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_low_power.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+
+/* Header file for local module */
+#include "radar_console.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Tickless idle with deep sleep between frames, selected with RADAR_LOW_POWER
+   in the Makefile */
+#ifndef RADAR_LOW_POWER_ENABLE
+#define RADAR_LOW_POWER_ENABLE (0)
+#endif
+
+/* Without the RX ring the terminal UI polls the UART, which wakes the CPU
+   every few ms, and deep sleep would drop the characters received by the
+   UART meanwhile */
+#if (RADAR_LOW_POWER_ENABLE == 1) && (RADAR_CONSOLE_RX_RING_ENABLE == 0)
+#error "RADAR_LOW_POWER=1 requires RADAR_CONSOLE_RX_RING=1"
+#endif
+
+/* Time in ms after the last received console character during which the
+   device only enters CPU sleep, so that the UART can receive the rest of the
+   user input */
+#define RADAR_LOW_POWER_CONSOLE_HOLD_MS (10000U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint64_t uptime_ms;        /* Time since the scheduler was started */
+    uint64_t deep_sleep_ms;    /* Time spent in deep sleep */
+    uint64_t sleep_ms;         /* Time spent in CPU sleep */
+    uint32_t deep_sleep_count; /* Number of deep sleep transitions */
+    uint32_t sleep_count;      /* Number of CPU sleep transitions */
+    uint32_t refused_count;    /* Deep sleep requests refused by a peripheral */
+} radar_low_power_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+#if (RADAR_LOW_POWER_ENABLE == 1)
+void radar_low_power_init(void);
+void radar_low_power_sleep(TickType_t expected_idle_ticks);
+void radar_low_power_get_stats(radar_low_power_stats_t *stats);
+#endif
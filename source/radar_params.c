@@ -0,0 +1,195 @@
+/*****************************************************************************
+** File name: radar_params.c
+**
+** Description: This file implements the parameter table of the radar presence
+** application. Every RadarSensing parameter is described once with its type,
+** range and default, values are checked when they are entered and only
+** converted to the strings of the library when they are applied.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file from system */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Header file for local module */
+#include "radar_params.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static const char *const sensitivity_choices[] =
+{
+    "low",
+    "medium",
+    "high"
+};
+
+/* Parameter table, indexed by radar_param_id_t */
+static const radar_param_info_t param_table[RADAR_PARAMS] =
+{
+    [RADAR_PARAM_RANGE_MAX] =
+    {
+        .key = "radar_presence_range_max",
+        .type = RADAR_PARAM_TYPE_FLOAT,
+        .min = 0.66f,
+        .max = 10.2f,
+        .choices = NULL,
+        .choice_count = 0U,
+        .default_value = { .number = 1.0f }
+    },
+    [RADAR_PARAM_SENSITIVITY] =
+    {
+        .key = "radar_presence_sensitivity",
+        .type = RADAR_PARAM_TYPE_ENUM,
+        .min = 0.0f,
+        .max = 0.0f,
+        .choices = sensitivity_choices,
+        .choice_count = sizeof(sensitivity_choices) / sizeof(sensitivity_choices[0]),
+        .default_value = { .choice = 1U }
+    }
+};
+
+/*******************************************************************************
+ * Function Name: radar_params_get_info
+ ********************************************************************************
+ * Summary:
+ *   Returns the table entry of a parameter
+ *
+ * Parameters:
+ *   id: parameter
+ *
+ * Return:
+ *   table entry
+ *******************************************************************************/
+const radar_param_info_t *radar_params_get_info(radar_param_id_t id)
+{
+    return &param_table[id];
+}
+
+/*******************************************************************************
+ * Function Name: radar_params_is_valid
+ ********************************************************************************
+ * Summary:
+ *   Checks a value against the type and range of a parameter
+ *
+ * Parameters:
+ *   id: parameter
+ *   value: value to check
+ *
+ * Return:
+ *   true if the value can be applied
+ *******************************************************************************/
+bool radar_params_is_valid(radar_param_id_t id, radar_param_value_t value)
+{
+    if ((uint32_t)id >= (uint32_t)RADAR_PARAMS)
+    {
+        return false;
+    }
+
+    const radar_param_info_t *info = &param_table[id];
+    if (info->type == RADAR_PARAM_TYPE_FLOAT)
+    {
+        /* Also false for NaN */
+        return (value.number >= info->min) && (value.number <= info->max);
+    }
+
+    return (value.choice < info->choice_count);
+}
+
+/*******************************************************************************
+ * Function Name: radar_params_parse
+ ********************************************************************************
+ * Summary:
+ *   Converts a value entered as text, a number or one of the choices, and
+ *   checks it.
+ *
+ * Parameters:
+ *   id: parameter
+ *   text: value as text
+ *   value: parsed value, only written if the text is valid
+ *
+ * Return:
+ *   true if the text is a valid value of the parameter
+ *******************************************************************************/
+bool radar_params_parse(radar_param_id_t id, const char *text, radar_param_value_t *value)
+{
+    const radar_param_info_t *info = &param_table[id];
+    radar_param_value_t parsed;
+
+    if (info->type == RADAR_PARAM_TYPE_FLOAT)
+    {
+        char *end;
+        parsed.number = strtof(text, &end);
+        if ((end == text) || (*end != '\0'))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        for (parsed.choice = 0U; parsed.choice < info->choice_count; parsed.choice++)
+        {
+            if (strcmp(text, info->choices[parsed.choice]) == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    if (!radar_params_is_valid(id, parsed))
+    {
+        return false;
+    }
+
+    *value = parsed;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: radar_params_format
+ ********************************************************************************
+ * Summary:
+ *   Converts a valid value to the string accepted by the RadarSensing
+ *   library, which is also the string shown on the console.
+ *
+ * Parameters:
+ *   id: parameter
+ *   value: value to convert
+ *   text: buffer for the string
+ *   size: size of the buffer, RADAR_PARAMS_VALUE_MAXLENGTH is enough
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_params_format(radar_param_id_t id, radar_param_value_t value, char *text, uint32_t size)
+{
+    const radar_param_info_t *info = &param_table[id];
+
+    if (info->type == RADAR_PARAM_TYPE_FLOAT)
+    {
+        (void)snprintf(text, size, "%.2f", (double)value.number);
+    }
+    else
+    {
+        (void)snprintf(text, size, "%s", info->choices[value.choice]);
+    }
+}
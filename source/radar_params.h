@@ -0,0 +1,80 @@
+/******************************************************************************
+** File name: radar_params.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_params.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Longest parameter value in the format of the RadarSensing library,
+   terminating zero included */
+#define RADAR_PARAMS_VALUE_MAXLENGTH (16U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* RadarSensing parameters of the application */
+typedef enum
+{
+    RADAR_PARAM_RANGE_MAX,   /* Presence range max in m */
+    RADAR_PARAM_SENSITIVITY, /* Presence sensitivity */
+    RADAR_PARAMS
+} radar_param_id_t;
+
+typedef enum
+{
+    RADAR_PARAM_TYPE_FLOAT, /* Number between min and max */
+    RADAR_PARAM_TYPE_ENUM   /* Index into the choices */
+} radar_param_type_t;
+
+typedef union
+{
+    float number;    /* RADAR_PARAM_TYPE_FLOAT */
+    uint32_t choice; /* RADAR_PARAM_TYPE_ENUM */
+} radar_param_value_t;
+
+/* Entry of the parameter table */
+typedef struct
+{
+    const char *key;                   /* RadarSensing parameter name */
+    radar_param_type_t type;
+    float min;                         /* Smallest value (FLOAT only) */
+    float max;                         /* Largest value (FLOAT only) */
+    const char *const *choices;        /* Library values by index (ENUM only) */
+    uint32_t choice_count;
+    radar_param_value_t default_value; /* Value unless a profile is saved */
+} radar_param_info_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+const radar_param_info_t *radar_params_get_info(radar_param_id_t id);
+bool radar_params_is_valid(radar_param_id_t id, radar_param_value_t value);
+bool radar_params_parse(radar_param_id_t id, const char *text, radar_param_value_t *value);
+void radar_params_format(radar_param_id_t id, radar_param_value_t value, char *text, uint32_t size);
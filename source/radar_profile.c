@@ -0,0 +1,201 @@
+/*****************************************************************************
+** File name: radar_profile.c
+**
+** Description: This file implements the saved settings of the radar presence
+** application: a versioned, CRC-checked profile in a row of the auxiliary
+** flash that is applied when the radar task starts.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file from system */
+#include <stddef.h>
+#include <string.h>
+
+/* Header file includes */
+#include "cy_pdl.h"
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_profile.h"
+#include "radar_stream.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Last row of the auxiliary flash, outside the part that the Em_EEPROM
+   middleware would use from the start, and not touched when the application is
+   programmed */
+#define RADAR_PROFILE_ADDRESS (CY_EM_EEPROM_BASE + CY_EM_EEPROM_SIZE - CY_FLASH_SIZEOF_ROW)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cyhal_flash_t profile_flash;
+
+/* Row image written by radar_profile_save, terminal UI task only */
+static uint32_t profile_row[CY_FLASH_SIZEOF_ROW / sizeof(uint32_t)];
+
+/*******************************************************************************
+ * Function Name: radar_profile_crc
+ ********************************************************************************
+ * Summary:
+ *   Computes the CRC of a profile
+ *
+ * Parameters:
+ *   profile: profile
+ *
+ * Return:
+ *   CRC of all fields before the CRC field
+ *******************************************************************************/
+static uint16_t radar_profile_crc(const radar_profile_t *profile)
+{
+    return radar_stream_crc(RADAR_STREAM_CRC_INIT, profile, offsetof(radar_profile_t, crc));
+}
+
+/*******************************************************************************
+ * Function Name: radar_profile_init
+ ********************************************************************************
+ * Summary:
+ *   Initializes the flash driver used to save the profile
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_profile_init(void)
+{
+    if (cyhal_flash_init(&profile_flash) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_profile_load
+ ********************************************************************************
+ * Summary:
+ *   Checks the saved profile in place. Nothing is copied, the flash is
+ *   memory mapped.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   saved profile, or NULL if none is saved or it has another version or a
+ *   wrong CRC, or a value is out of the parameter table
+ *******************************************************************************/
+const radar_profile_t *radar_profile_load(void)
+{
+    const radar_profile_t *profile = (const radar_profile_t *)RADAR_PROFILE_ADDRESS;
+
+    if ((profile->magic != RADAR_PROFILE_MAGIC) || (profile->version != RADAR_PROFILE_VERSION) ||
+        (profile->length != sizeof(radar_profile_t)) || (profile->crc != radar_profile_crc(profile)))
+    {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < RADAR_PROFILE_PARAMS; i++)
+    {
+        if (!radar_params_is_valid((radar_param_id_t)i, profile->values[i]))
+        {
+            return NULL;
+        }
+    }
+
+    return profile;
+}
+
+/*******************************************************************************
+ * Function Name: radar_profile_get_params
+ ********************************************************************************
+ * Summary:
+ *   Lists the parameters of a profile for radar_task_set_parameters().
+ *
+ * Parameters:
+ *   profile: profile returned by radar_profile_load
+ *   params: RADAR_PROFILE_PARAMS entries for the parameters
+ *
+ * Return:
+ *   number of parameters
+ *******************************************************************************/
+uint32_t radar_profile_get_params(const radar_profile_t *profile, radar_task_param_t *params)
+{
+    for (uint32_t i = 0; i < RADAR_PROFILE_PARAMS; i++)
+    {
+        params[i].id = (radar_param_id_t)i;
+        params[i].value = profile->values[i];
+    }
+
+    return RADAR_PROFILE_PARAMS;
+}
+
+/*******************************************************************************
+ * Function Name: radar_profile_save
+ ********************************************************************************
+ * Summary:
+ *   Saves the current parameters and adaptive frame rate policy. The flash
+ *   row is written and read back. Must not be called by the radar task.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   true if the profile has been saved
+ *******************************************************************************/
+bool radar_profile_save(void)
+{
+    radar_profile_t *profile = (radar_profile_t *)profile_row;
+
+    memset(profile_row, 0, sizeof(profile_row));
+    profile->magic = RADAR_PROFILE_MAGIC;
+    profile->version = RADAR_PROFILE_VERSION;
+    profile->length = sizeof(radar_profile_t);
+    radar_task_get_values(profile->values);
+    radar_adaptive_get_config(&profile->adaptive);
+    profile->crc = radar_profile_crc(profile);
+
+    if (cyhal_flash_write(&profile_flash, RADAR_PROFILE_ADDRESS, profile_row) != CY_RSLT_SUCCESS)
+    {
+        return false;
+    }
+
+    return (memcmp((const void *)RADAR_PROFILE_ADDRESS, profile_row, sizeof(profile_row)) == 0);
+}
+
+/*******************************************************************************
+ * Function Name: radar_profile_erase
+ ********************************************************************************
+ * Summary:
+ *   Erases the saved profile, so that the next start uses the defaults. Must
+ *   not be called by the radar task.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   true if the profile has been erased
+ *******************************************************************************/
+bool radar_profile_erase(void)
+{
+    return (cyhal_flash_erase(&profile_flash, RADAR_PROFILE_ADDRESS) == CY_RSLT_SUCCESS);
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+** File name: radar_profile.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_profile.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Header file for local module */
+#include "radar_adaptive.h"
+#include "radar_params.h"
+#include "radar_task.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Identifies a profile row */
+#define RADAR_PROFILE_MAGIC (0x46525052UL) /* "RPRF" */
+/* Layout version, to be incremented whenever radar_profile_t or the list of
+   saved parameters changes. Profiles of another version are ignored. */
+#define RADAR_PROFILE_VERSION (2U)
+/* Number of saved RadarSensing parameters, all entries of the parameter
+   table */
+#define RADAR_PROFILE_PARAMS (RADAR_PARAMS)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Saved settings, stored as they are in a flash row. The values are typed as
+   in the parameter table and checked against it when the row is loaded. */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t length;                                  /* sizeof(radar_profile_t) */
+    radar_param_value_t values[RADAR_PROFILE_PARAMS]; /* Parameter values, indexed by radar_param_id_t */
+    radar_adaptive_config_t adaptive;                 /* Adaptive frame rate policy */
+    uint16_t crc;                                     /* CRC-16/CCITT-FALSE of the fields above */
+} radar_profile_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void radar_profile_init(void);
+const radar_profile_t *radar_profile_load(void);
+uint32_t radar_profile_get_params(const radar_profile_t *profile, radar_task_param_t *params);
+bool radar_profile_save(void);
+bool radar_profile_erase(void);
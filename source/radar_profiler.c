@@ -0,0 +1,223 @@
+/*****************************************************************************
+** File name: radar_profiler.c
+**
+** Description: This file implements profiling of the radar processing path
+** with the Cortex-M4 DWT cycle counter. Durations are kept as min/max/mean
+** and a log2-bucketed histogram in RAM.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file for local module */
+#include "radar_profiler.h"
+
+#if (RADAR_PROFILER_ENABLE == 1)
+
+/* Header file from system */
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+
+/* Header file for local module */
+#include "radar_time.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static radar_profiler_stats_t profiler_stats[RADAR_PROFILER_SECTIONS];
+/* Start of the measurement window */
+static uint64_t profiler_reset_us;
+
+static const char *const profiler_section_names[RADAR_PROFILER_SECTIONS] =
+{
+    "process()",
+    "callback"
+};
+
+/*******************************************************************************
+ * Function Name: radar_profiler_clear
+ ********************************************************************************
+ * Summary:
+ *   Clears the statistics of a section
+ *
+ * Parameters:
+ *   stats: statistics of the section
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_profiler_clear(radar_profiler_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->min = UINT32_MAX;
+}
+
+/*******************************************************************************
+ * Function Name: radar_profiler_init
+ ********************************************************************************
+ * Summary:
+ *   Enables the DWT cycle counter and clears all statistics
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_profiler_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    radar_profiler_reset();
+}
+
+/*******************************************************************************
+ * Function Name: radar_profiler_record
+ ********************************************************************************
+ * Summary:
+ *   Records the duration of a profiled section that started at the given
+ *   cycle count and ends now. The cycle counter wraps after 2^32 cycles, so
+ *   sections must be shorter than that.
+ *
+ * Parameters:
+ *   section: profiled section
+ *   start: cycle count at the start of the section
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_profiler_record(radar_profiler_section_t section, uint32_t start)
+{
+    uint32_t cycles = radar_profiler_cycles() - start;
+    radar_profiler_stats_t *stats = &profiler_stats[section];
+    uint32_t bucket = (cycles == 0U) ? 0U : (31U - __CLZ(cycles));
+
+    stats->count++;
+    stats->sum += cycles;
+    if (cycles < stats->min)
+    {
+        stats->min = cycles;
+    }
+    if (cycles > stats->max)
+    {
+        stats->max = cycles;
+    }
+    stats->histogram[bucket]++;
+}
+
+/*******************************************************************************
+ * Function Name: radar_profiler_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Returns a consistent snapshot of the statistics of a section
+ *
+ * Parameters:
+ *   section: profiled section
+ *   stats: snapshot of the statistics
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_profiler_get_stats(radar_profiler_section_t section, radar_profiler_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = profiler_stats[section];
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+ * Function Name: radar_profiler_reset
+ ********************************************************************************
+ * Summary:
+ *   Clears the statistics of all sections
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_profiler_reset(void)
+{
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < RADAR_PROFILER_SECTIONS; i++)
+    {
+        radar_profiler_clear(&profiler_stats[i]);
+    }
+    profiler_reset_us = radar_time_us();
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+ * Function Name: radar_profiler_print
+ ********************************************************************************
+ * Summary:
+ *   Prints the length of the measurement window, then the statistics and
+ *   the non-empty histogram buckets of all sections
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_profiler_print(void)
+{
+    radar_profiler_stats_t stats;
+    float us_per_cycle = 1000000.0f / (float)SystemCoreClock;
+
+    printf("Window: %.3f s\n", (float)(radar_time_us() - profiler_reset_us) / 1000000.0f);
+    for (uint32_t i = 0; i < RADAR_PROFILER_SECTIONS; i++)
+    {
+        radar_profiler_get_stats((radar_profiler_section_t)i, &stats);
+
+        printf("%s: %" PRIu32 " calls\n", profiler_section_names[i], stats.count);
+        if (stats.count == 0U)
+        {
+            continue;
+        }
+
+        uint32_t mean = (uint32_t)(stats.sum / stats.count);
+        printf("  min %" PRIu32 " / mean %" PRIu32 " / max %" PRIu32 " cycles (%.1f / %.1f / %.1f us)\n",
+               stats.min,
+               mean,
+               stats.max,
+               (float)stats.min * us_per_cycle,
+               (float)mean * us_per_cycle,
+               (float)stats.max * us_per_cycle);
+
+        for (uint32_t bucket = 0; bucket < RADAR_PROFILER_BUCKETS; bucket++)
+        {
+            if (stats.histogram[bucket] != 0U)
+            {
+                printf("  [2^%02" PRIu32 ", 2^%02" PRIu32 ") cycles: %" PRIu32 "\n",
+                       bucket,
+                       bucket + 1U,
+                       stats.histogram[bucket]);
+            }
+        }
+    }
+}
+
+#endif /* RADAR_PROFILER_ENABLE */
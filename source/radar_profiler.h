@@ -0,0 +1,101 @@
+/******************************************************************************
+** File name: radar_profiler.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_profiler.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdint.h>
+
+/* Header file includes */
+#include "cy_pdl.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* DWT cycle counter profiling, selected with RADAR_PROFILER in the Makefile */
+#ifndef RADAR_PROFILER_ENABLE
+#define RADAR_PROFILER_ENABLE (0)
+#endif
+
+/* Number of histogram buckets. Bucket i counts durations of
+   [2^i, 2^(i+1)) cycles, bucket 0 also counts durations of 0 cycles. */
+#define RADAR_PROFILER_BUCKETS (32U)
+
+#if (RADAR_PROFILER_ENABLE == 1)
+/* Marks the start of a profiled section */
+#define RADAR_PROFILER_START(start) uint32_t start = radar_profiler_cycles()
+/* Marks the end of a profiled section and records its duration */
+#define RADAR_PROFILER_STOP(id, start) radar_profiler_record((id), (start))
+#else
+#define RADAR_PROFILER_START(start)
+#define RADAR_PROFILER_STOP(id, start)
+#endif
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef enum
+{
+    RADAR_PROFILER_PROCESS,  /* mtb_radar_sensing_process(), callback included */
+    RADAR_PROFILER_CALLBACK, /* radar_sensing_callback() */
+    RADAR_PROFILER_SECTIONS
+} radar_profiler_section_t;
+
+typedef struct
+{
+    uint32_t count; /* Number of recorded durations */
+    uint32_t min;   /* Shortest duration in cycles */
+    uint32_t max;   /* Longest duration in cycles */
+    uint64_t sum;   /* Sum of all durations in cycles */
+    uint32_t histogram[RADAR_PROFILER_BUCKETS];
+} radar_profiler_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+#if (RADAR_PROFILER_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: radar_profiler_cycles
+ ********************************************************************************
+ * Summary:
+ *   Reads the DWT cycle counter
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   current value of the cycle counter
+ *******************************************************************************/
+static inline uint32_t radar_profiler_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+void radar_profiler_init(void);
+void radar_profiler_record(radar_profiler_section_t section, uint32_t start);
+void radar_profiler_get_stats(radar_profiler_section_t section, radar_profiler_stats_t *stats);
+void radar_profiler_reset(void);
+void radar_profiler_print(void);
+#endif
@@ -0,0 +1,169 @@
+/*****************************************************************************
+** File name: radar_rtos.c
+**
+** Description: This file creates the tasks and sync objects of the radar
+** presence application, either from statically allocated memory or from the
+** heap, depending on RADAR_STATIC_MEMORY.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file for local module */
+#include "radar_rtos.h"
+
+/*******************************************************************************
+ * Function Name: radar_rtos_create_thread
+ ********************************************************************************
+ * Summary:
+ *   Creates a task. If stack and TCB are given, the task is created in that
+ *   memory, otherwise both are allocated from the heap.
+ *
+ * Parameters:
+ *   thread: handle of the created task
+ *   entry_function: task entry function, called with a NULL argument
+ *   name: task name
+ *   stack: stack of stack_size bytes, or NULL
+ *   tcb: task control block, or NULL
+ *   stack_size: stack size in bytes
+ *   priority: task priority
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS if the task was created
+ *******************************************************************************/
+cy_rslt_t radar_rtos_create_thread(cy_thread_t *thread,
+                                   cy_thread_entry_fn_t entry_function,
+                                   const char *name,
+                                   StackType_t *stack,
+                                   StaticTask_t *tcb,
+                                   uint32_t stack_size,
+                                   cy_thread_priority_t priority)
+{
+    if ((stack == NULL) || (tcb == NULL))
+    {
+        return cy_rtos_create_thread(thread, entry_function, name, NULL, stack_size, priority, (cy_thread_arg_t)NULL);
+    }
+
+    *thread = xTaskCreateStatic(entry_function,
+                                name,
+                                stack_size / sizeof(StackType_t),
+                                NULL,
+                                (UBaseType_t)priority,
+                                stack,
+                                tcb);
+
+    return (*thread != NULL) ? CY_RSLT_SUCCESS : CY_RTOS_NO_MEMORY;
+}
+
+/*******************************************************************************
+ * Function Name: radar_rtos_exit_thread
+ ********************************************************************************
+ * Summary:
+ *   Ends the calling task. Tasks created from static memory are not known to
+ *   the RTOS abstraction and are deleted directly, their memory stays
+ *   reserved.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_rtos_exit_thread(void)
+{
+#if (RADAR_STATIC_MEMORY_ENABLE == 1)
+    vTaskDelete(NULL);
+#else
+    (void)cy_rtos_exit_thread();
+#endif
+}
+
+/*******************************************************************************
+ * Function Name: radar_rtos_init_mutex
+ ********************************************************************************
+ * Summary:
+ *   Creates a recursive mutex, in the given storage or on the heap.
+ *
+ * Parameters:
+ *   mutex: handle of the created mutex
+ *   storage: mutex storage, or NULL
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS if the mutex was created
+ *******************************************************************************/
+cy_rslt_t radar_rtos_init_mutex(SemaphoreHandle_t *mutex, StaticSemaphore_t *storage)
+{
+    *mutex = (storage != NULL) ? xSemaphoreCreateRecursiveMutexStatic(storage) : xSemaphoreCreateRecursiveMutex();
+
+    return (*mutex != NULL) ? CY_RSLT_SUCCESS : CY_RTOS_NO_MEMORY;
+}
+
+/*******************************************************************************
+ * Function Name: radar_rtos_init_binary_semaphore
+ ********************************************************************************
+ * Summary:
+ *   Creates a binary semaphore that is initially taken, in the given storage
+ *   or on the heap.
+ *
+ * Parameters:
+ *   semaphore: handle of the created semaphore
+ *   storage: semaphore storage, or NULL
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS if the semaphore was created
+ *******************************************************************************/
+cy_rslt_t radar_rtos_init_binary_semaphore(SemaphoreHandle_t *semaphore, StaticSemaphore_t *storage)
+{
+    *semaphore = (storage != NULL) ? xSemaphoreCreateBinaryStatic(storage) : xSemaphoreCreateBinary();
+
+    return (*semaphore != NULL) ? CY_RSLT_SUCCESS : CY_RTOS_NO_MEMORY;
+}
+
+/*******************************************************************************
+ * Function Name: radar_rtos_init_queue
+ ********************************************************************************
+ * Summary:
+ *   Creates a queue, in the given item buffer and storage or on the heap.
+ *
+ * Parameters:
+ *   queue: handle of the created queue
+ *   length: maximum number of items
+ *   item_size: size of an item in bytes
+ *   items: buffer of length * item_size bytes, or NULL
+ *   storage: queue storage, or NULL
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS if the queue was created
+ *******************************************************************************/
+cy_rslt_t radar_rtos_init_queue(QueueHandle_t *queue,
+                                uint32_t length,
+                                uint32_t item_size,
+                                uint8_t *items,
+                                StaticQueue_t *storage)
+{
+    if ((items == NULL) || (storage == NULL))
+    {
+        *queue = xQueueCreate(length, item_size);
+    }
+    else
+    {
+        *queue = xQueueCreateStatic(length, item_size, items, storage);
+    }
+
+    return (*queue != NULL) ? CY_RSLT_SUCCESS : CY_RTOS_NO_MEMORY;
+}
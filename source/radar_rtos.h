@@ -0,0 +1,77 @@
+/******************************************************************************
+** File name: radar_rtos.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_rtos.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdint.h>
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+#include "queue.h"
+#include "semphr.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Static allocation of all application tasks and sync objects, selected with
+   RADAR_STATIC_MEMORY in the Makefile */
+#ifndef RADAR_STATIC_MEMORY_ENABLE
+#define RADAR_STATIC_MEMORY_ENABLE (0)
+#endif
+
+#if (RADAR_STATIC_MEMORY_ENABLE == 1)
+/* Arguments passing the stack and TCB of a task to radar_rtos_create_thread */
+#define RADAR_RTOS_TASK_MEMORY(task) (task##_stack), (&task##_tcb)
+/* Argument passing the storage of a sync object to radar_rtos_init_* */
+#define RADAR_RTOS_OBJECT_MEMORY(object) (&object##_storage)
+/* Arguments passing the item buffer and storage of a queue to
+   radar_rtos_init_queue */
+#define RADAR_RTOS_QUEUE_MEMORY(queue) (queue##_items), (&queue##_storage)
+#else
+#define RADAR_RTOS_TASK_MEMORY(task) NULL, NULL
+#define RADAR_RTOS_OBJECT_MEMORY(object) NULL
+#define RADAR_RTOS_QUEUE_MEMORY(queue) NULL, NULL
+#endif
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+cy_rslt_t radar_rtos_create_thread(cy_thread_t *thread,
+                                   cy_thread_entry_fn_t entry_function,
+                                   const char *name,
+                                   StackType_t *stack,
+                                   StaticTask_t *tcb,
+                                   uint32_t stack_size,
+                                   cy_thread_priority_t priority);
+void radar_rtos_exit_thread(void);
+cy_rslt_t radar_rtos_init_mutex(SemaphoreHandle_t *mutex, StaticSemaphore_t *storage);
+cy_rslt_t radar_rtos_init_binary_semaphore(SemaphoreHandle_t *semaphore, StaticSemaphore_t *storage);
+cy_rslt_t radar_rtos_init_queue(QueueHandle_t *queue,
+                                uint32_t length,
+                                uint32_t item_size,
+                                uint8_t *items,
+                                StaticQueue_t *storage);
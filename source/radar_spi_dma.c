@@ -0,0 +1,246 @@
+/*****************************************************************************
+** File name: radar_spi_dma.c
+**
+** Description: This file hooks into the SPI transfers of the radar driver.
+** The driver calls cyhal_spi_transfer(), which the linker redirects to
+** __wrap_cyhal_spi_transfer(). With RADAR_SPI_DMA, long transfers are started
+** asynchronously and the calling task blocks until the DMA completes, so that
+** the CPU is free for other tasks during a FIFO burst. With RADAR_CAPTURE,
+** the received FIFO data is handed to the frame capture.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file for local module */
+#include "radar_spi_dma.h"
+
+#if (RADAR_SPI_DMA_ENABLE == 1) || (RADAR_CAPTURE_ENABLE == 1)
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+
+/* Header file for local module */
+#include "radar_capture.h"
+#include "radar_rtos.h"
+
+/* Original cyhal_spi_transfer(), see --wrap in the Makefile */
+cy_rslt_t __real_cyhal_spi_transfer(cyhal_spi_t *obj,
+                                    const uint8_t *tx,
+                                    size_t tx_length,
+                                    uint8_t *rx,
+                                    size_t rx_length,
+                                    uint8_t write_fill);
+
+#endif
+
+#if (RADAR_SPI_DMA_ENABLE == 1)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cyhal_spi_t *dma_spi;
+static SemaphoreHandle_t dma_done;
+#if (RADAR_STATIC_MEMORY_ENABLE == 1)
+static StaticSemaphore_t dma_done_storage;
+#endif
+static radar_spi_dma_stats_t dma_stats;
+
+/*******************************************************************************
+ * Function Name: radar_spi_dma_event_handler
+ ********************************************************************************
+ * Summary:
+ *   SPI event handler. Releases the task that waits for the end of the DMA
+ *   transfer.
+ *
+ * Parameters:
+ *   callback_arg: not used
+ *   event: SPI event
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_spi_dma_event_handler(void *callback_arg, cyhal_spi_event_t event)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    if ((event & CYHAL_SPI_IRQ_DONE) != 0U)
+    {
+        (void)xSemaphoreGiveFromISR(dma_done, &higher_priority_task_woken);
+    }
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************
+ * Function Name: radar_spi_dma_init
+ ********************************************************************************
+ * Summary:
+ *   Switches the asynchronous transfers of the SPI block to DMA and enables
+ *   the transfer-done event. Must be called by the task that owns the SPI
+ *   block, after cyhal_spi_init().
+ *
+ * Parameters:
+ *   spi: SPI block of the radar
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_spi_dma_init(cyhal_spi_t *spi)
+{
+    if (radar_rtos_init_binary_semaphore(&dma_done, RADAR_RTOS_OBJECT_MEMORY(dma_done)) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (cyhal_spi_set_async_mode(spi, CYHAL_ASYNC_DMA, CYHAL_DMA_PRIORITY_DEFAULT) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    cyhal_spi_register_callback(spi, radar_spi_dma_event_handler, NULL);
+    cyhal_spi_enable_event(spi, CYHAL_SPI_IRQ_DONE, RADAR_SPI_DMA_IRQ_PRIORITY, true);
+
+    dma_spi = spi;
+}
+
+/*******************************************************************************
+ * Function Name: radar_spi_dma_transfer
+ ********************************************************************************
+ * Summary:
+ *   Transfers on the radar SPI block of at least RADAR_SPI_DMA_THRESHOLD
+ *   bytes are done by DMA while the calling task sleeps, all others are
+ *   passed on unchanged. The call keeps its blocking semantics, so chip
+ *   select handling in the driver is not affected.
+ *
+ * Parameters:
+ *   obj: SPI block
+ *   tx: bytes to transmit
+ *   tx_length: number of bytes to transmit
+ *   rx: buffer for the received bytes
+ *   rx_length: number of bytes to receive
+ *   write_fill: byte transmitted once tx is exhausted
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS if the transfer completed
+ *******************************************************************************/
+static cy_rslt_t radar_spi_dma_transfer(cyhal_spi_t *obj,
+                                        const uint8_t *tx,
+                                        size_t tx_length,
+                                        uint8_t *rx,
+                                        size_t rx_length,
+                                        uint8_t write_fill)
+{
+    size_t length = (tx_length > rx_length) ? tx_length : rx_length;
+
+    if ((obj != dma_spi) || (length < RADAR_SPI_DMA_THRESHOLD))
+    {
+        if (obj == dma_spi)
+        {
+            dma_stats.cpu_transfers++;
+        }
+        return __real_cyhal_spi_transfer(obj, tx, tx_length, rx, rx_length, write_fill);
+    }
+
+    /* The asynchronous transfer pads a short tx with the write_fill latched
+       by the last blocking transfer. The driver uses one fill value for all
+       accesses, and its short register accesses always precede a burst. */
+    cy_rslt_t result = cyhal_spi_transfer_async(obj, tx, tx_length, rx, rx_length);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    if (xSemaphoreTake(dma_done, RADAR_SPI_DMA_TIMEOUT) != pdTRUE)
+    {
+        (void)cyhal_spi_abort_async(obj);
+        /* Drop a completion that raced with the abort */
+        (void)xSemaphoreTake(dma_done, 0);
+        dma_stats.timeouts++;
+        return CY_RTOS_TIMEOUT;
+    }
+
+    dma_stats.dma_transfers++;
+    dma_stats.dma_bytes += length;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: radar_spi_dma_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Returns the transfer counters
+ *
+ * Parameters:
+ *   stats: snapshot of the counters
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_spi_dma_get_stats(radar_spi_dma_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = dma_stats;
+    taskEXIT_CRITICAL();
+}
+
+#endif /* RADAR_SPI_DMA_ENABLE */
+
+#if (RADAR_SPI_DMA_ENABLE == 1) || (RADAR_CAPTURE_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: __wrap_cyhal_spi_transfer
+ ********************************************************************************
+ * Summary:
+ *   Replaces cyhal_spi_transfer() for the whole application. Does the
+ *   transfer by DMA or by the CPU, then passes the received data to the
+ *   frame capture.
+ *
+ * Parameters:
+ *   obj: SPI block
+ *   tx: bytes to transmit
+ *   tx_length: number of bytes to transmit
+ *   rx: buffer for the received bytes
+ *   rx_length: number of bytes to receive
+ *   write_fill: byte transmitted once tx is exhausted
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS if the transfer completed
+ *******************************************************************************/
+cy_rslt_t __wrap_cyhal_spi_transfer(cyhal_spi_t *obj,
+                                    const uint8_t *tx,
+                                    size_t tx_length,
+                                    uint8_t *rx,
+                                    size_t rx_length,
+                                    uint8_t write_fill)
+{
+#if (RADAR_SPI_DMA_ENABLE == 1)
+    cy_rslt_t result = radar_spi_dma_transfer(obj, tx, tx_length, rx, rx_length, write_fill);
+#else
+    cy_rslt_t result = __real_cyhal_spi_transfer(obj, tx, tx_length, rx, rx_length, write_fill);
+#endif
+
+#if (RADAR_CAPTURE_ENABLE == 1)
+    if ((result == CY_RSLT_SUCCESS) && (rx != NULL))
+    {
+        radar_capture_spi_data(rx, rx_length);
+    }
+#endif
+
+    return result;
+}
+#endif
@@ -0,0 +1,70 @@
+/******************************************************************************
+** File name: radar_spi_dma.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_spi_dma.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdint.h>
+
+/* Header file includes */
+#include "cyhal.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* DMA-backed SPI transfers of the radar driver, selected with RADAR_SPI_DMA in
+   the Makefile */
+#ifndef RADAR_SPI_DMA_ENABLE
+#define RADAR_SPI_DMA_ENABLE (0)
+#endif
+
+/* Transfers of at least this many bytes use DMA, shorter register accesses
+   stay on the blocking path where the DMA setup would cost more than it
+   saves */
+#define RADAR_SPI_DMA_THRESHOLD (64U)
+/* Longest time a DMA transfer may take before it is aborted */
+#define RADAR_SPI_DMA_TIMEOUT pdMS_TO_TICKS(20)
+/* Interrupt priority of the SPI transfer-done event */
+#define RADAR_SPI_DMA_IRQ_PRIORITY (CYHAL_ISR_PRIORITY_DEFAULT)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t dma_transfers;  /* Transfers done by DMA */
+    uint64_t dma_bytes;      /* Bytes moved by DMA */
+    uint32_t cpu_transfers;  /* Transfers below the threshold, done by the CPU */
+    uint32_t timeouts;       /* DMA transfers aborted after RADAR_SPI_DMA_TIMEOUT */
+} radar_spi_dma_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+#if (RADAR_SPI_DMA_ENABLE == 1)
+void radar_spi_dma_init(cyhal_spi_t *spi);
+void radar_spi_dma_get_stats(radar_spi_dma_stats_t *stats);
+#endif
@@ -0,0 +1,277 @@
+/*****************************************************************************
+** File name: radar_stats.c
+**
+** Description: This file implements the task report of the radar presence
+** application: CPU usage from the FreeRTOS run-time stats, stack high-water
+** marks and free heap.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file from system */
+#include <inttypes.h>
+#include <stdio.h>
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+#include "cyhal.h"
+
+#if (configHEAP_ALLOCATION_SCHEME == HEAP_ALLOCATION_TYPE3)
+/* Header file from system, for the newlib heap statistics */
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+/* Header file for local module */
+#include "radar_stats.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+static cyhal_timer_t stats_timer;
+#endif
+
+static TaskStatus_t task_status[RADAR_STATS_MAX_TASKS];
+
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+/* Run-time counters of the previous report. The 32-bit counters wrap after
+   about 11.9 hours at RADAR_STATS_TIMER_FREQUENCY, so the CPU usage is
+   computed from the differences to the previous report, which survive a
+   wrap. */
+typedef struct
+{
+    UBaseType_t task_number;
+    uint32_t runtime;
+} radar_stats_runtime_t;
+
+static radar_stats_runtime_t last_runtime[RADAR_STATS_MAX_TASKS];
+static UBaseType_t last_count;
+static uint32_t last_total_runtime;
+#endif
+
+#if (configHEAP_ALLOCATION_SCHEME == HEAP_ALLOCATION_TYPE3)
+/* End of the heap region, defined by the linker script */
+extern uint8_t __HeapLimit;
+#endif
+
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: radar_stats_timer_init
+ ********************************************************************************
+ * Summary:
+ *   Starts a free-running hardware timer as the FreeRTOS run-time stats
+ *   clock. Called by the scheduler through
+ *   portCONFIGURE_TIMER_FOR_RUN_TIME_STATS.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_stats_timer_init(void)
+{
+    const cyhal_timer_cfg_t timer_cfg =
+    {
+        .is_continuous = true,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .period = UINT32_MAX,
+        .compare_value = 0,
+        .value = 0
+    };
+
+    if (cyhal_timer_init(&stats_timer, NC, NULL) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    if (cyhal_timer_configure(&stats_timer, &timer_cfg) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    if (cyhal_timer_set_frequency(&stats_timer, RADAR_STATS_TIMER_FREQUENCY) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    if (cyhal_timer_start(&stats_timer) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_stats_timer_read
+ ********************************************************************************
+ * Summary:
+ *   Reads the run-time stats clock. Called by the scheduler through
+ *   portGET_RUN_TIME_COUNTER_VALUE.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   timer count
+ *******************************************************************************/
+uint32_t radar_stats_timer_read(void)
+{
+    return cyhal_timer_read(&stats_timer);
+}
+
+/*******************************************************************************
+ * Function Name: radar_stats_get_idle
+ ********************************************************************************
+ * Summary:
+ *   Reads the run time of the idle task and the run-time stats clock. The
+ *   idle fraction of a measurement is the ratio of their differences.
+ *
+ * Parameters:
+ *   idle: receives the run time of the idle task in timer counts
+ *   total: receives the timer count
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_stats_get_idle(uint32_t *idle, uint32_t *total)
+{
+    taskENTER_CRITICAL();
+    *idle = ulTaskGetIdleRunTimeCounter();
+    *total = radar_stats_timer_read();
+    taskEXIT_CRITICAL();
+}
+#endif
+
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: radar_stats_last_runtime
+ ********************************************************************************
+ * Summary:
+ *   Returns the run-time counter of a task at the previous report
+ *
+ * Parameters:
+ *   task_number: unique number of the task
+ *
+ * Return:
+ *   counter, 0 for a task that was not in the previous report
+ *******************************************************************************/
+static uint32_t radar_stats_last_runtime(UBaseType_t task_number)
+{
+    for (UBaseType_t i = 0; i < last_count; i++)
+    {
+        if (last_runtime[i].task_number == task_number)
+        {
+            return last_runtime[i].runtime;
+        }
+    }
+    return 0U;
+}
+#endif
+
+/*******************************************************************************
+ * Function Name: radar_stats_free_heap
+ ********************************************************************************
+ * Summary:
+ *   Returns the number of bytes that can still be allocated from the heap
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   free heap in bytes
+ *******************************************************************************/
+static size_t radar_stats_free_heap(void)
+{
+#if (configHEAP_ALLOCATION_SCHEME == HEAP_ALLOCATION_TYPE3)
+    /* heap_3 uses newlib malloc: free blocks inside the arena plus the part
+       of the heap region that has not been claimed by sbrk yet */
+    struct mallinfo info = mallinfo();
+    uint8_t *heap_end = (uint8_t *)sbrk(0);
+    return info.fordblks + (size_t)(&__HeapLimit - heap_end);
+#else
+    return xPortGetFreeHeapSize();
+#endif
+}
+
+/*******************************************************************************
+ * Function Name: radar_stats_print_tasks
+ ********************************************************************************
+ * Summary:
+ *   Prints priority, CPU usage (if run-time stats are enabled) and stack
+ *   high-water mark of every task, followed by the free heap. The CPU usage
+ *   covers the time since the previous report, or since startup for the
+ *   first one.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_stats_print_tasks(void)
+{
+    uint32_t total_runtime = 0;
+    UBaseType_t count = uxTaskGetSystemState(task_status, RADAR_STATS_MAX_TASKS, &total_runtime);
+
+    if (count == 0U)
+    {
+        printf("Too many tasks for the report (max %u)\n", (unsigned int)RADAR_STATS_MAX_TASKS);
+        return;
+    }
+
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+    /* Unsigned differences, also correct across a wrap */
+    uint32_t period = total_runtime - last_total_runtime;
+    printf("CPU usage of the last %" PRIu32 " s\n", (uint32_t)(period / RADAR_STATS_TIMER_FREQUENCY));
+#endif
+    printf("%-*s prio    cpu  stack free\n", configMAX_TASK_NAME_LEN, "task");
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        const TaskStatus_t *status = &task_status[i];
+        uint32_t stack_free = (uint32_t)status->usStackHighWaterMark * sizeof(StackType_t);
+
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+        uint32_t runtime = status->ulRunTimeCounter - radar_stats_last_runtime(status->xTaskNumber);
+        float cpu = (period > 0U) ? ((float)runtime * 100.0f / (float)period) : 0.0f;
+        printf("%-*s %4u %5.1f%% %6" PRIu32 " B\n",
+               configMAX_TASK_NAME_LEN,
+               status->pcTaskName,
+               (unsigned int)status->uxCurrentPriority,
+               cpu,
+               stack_free);
+#else
+        printf("%-*s %4u      - %6" PRIu32 " B\n",
+               configMAX_TASK_NAME_LEN,
+               status->pcTaskName,
+               (unsigned int)status->uxCurrentPriority,
+               stack_free);
+#endif
+    }
+
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        last_runtime[i].task_number = task_status[i].xTaskNumber;
+        last_runtime[i].runtime = task_status[i].ulRunTimeCounter;
+    }
+    last_count = count;
+    last_total_runtime = total_runtime;
+#endif
+
+    printf("Free heap: %u B\n", (unsigned int)radar_stats_free_heap());
+}
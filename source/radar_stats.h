@@ -0,0 +1,53 @@
+/******************************************************************************
+** File name: radar_stats.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_stats.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* FreeRTOS run-time stats driven by a hardware timer, selected with
+   RADAR_RUNTIME_STATS in the Makefile */
+#ifndef RADAR_RUNTIME_STATS_ENABLE
+#define RADAR_RUNTIME_STATS_ENABLE (0)
+#endif
+
+/* Frequency of the run-time stats timer */
+#define RADAR_STATS_TIMER_FREQUENCY (100000UL)
+/* Maximum number of tasks in the task report */
+#define RADAR_STATS_MAX_TASKS (12U)
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+void radar_stats_timer_init(void);
+uint32_t radar_stats_timer_read(void);
+void radar_stats_get_idle(uint32_t *idle, uint32_t *total);
+#endif
+void radar_stats_print_tasks(void);
@@ -0,0 +1,237 @@
+/*****************************************************************************
+** File name: radar_stream.c
+**
+** Description: This file implements the binary record format on the console
+** UART. Every record starts with a type byte and ends with a CRC-16, and is
+** COBS encoded, so that a record contains no zero byte. Records are
+** delimited by zero bytes, which lets the host resynchronize after text
+** output or a lost byte.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file includes */
+#include "cy_retarget_io.h"
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_stream.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* CRC-16/CCITT-FALSE polynomial */
+#define RADAR_STREAM_CRC_POLY (0x1021U)
+/* Record delimiter */
+#define RADAR_STREAM_DELIMITER (0x00U)
+
+/*******************************************************************************
+ * Function Name: radar_stream_putc
+ ********************************************************************************
+ * Summary:
+ *   Writes one byte to the console UART. Bypasses retarget-io, which would
+ *   convert LF bytes to CRLF.
+ *
+ * Parameters:
+ *   value: byte to write
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_stream_putc(uint8_t value)
+{
+    (void)cyhal_uart_putc(&cy_retarget_io_uart_obj, value);
+}
+
+/*******************************************************************************
+ * Function Name: radar_stream_flush_block
+ ********************************************************************************
+ * Summary:
+ *   Writes the pending COBS block: a code byte with the block length plus one,
+ *   followed by the block.
+ *
+ * Parameters:
+ *   stream: encoder state
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_stream_flush_block(radar_stream_t *stream)
+{
+    radar_stream_putc((uint8_t)(stream->count + 1U));
+    for (uint32_t i = 0; i < stream->count; i++)
+    {
+        radar_stream_putc(stream->block[i]);
+    }
+    stream->count = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: radar_stream_encode
+ ********************************************************************************
+ * Summary:
+ *   COBS encodes one byte of the record. A zero byte closes the current
+ *   block, a full block is written without an implied zero.
+ *
+ * Parameters:
+ *   stream: encoder state
+ *   value: byte of the record
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_stream_encode(radar_stream_t *stream, uint8_t value)
+{
+    if (value == 0U)
+    {
+        radar_stream_flush_block(stream);
+        return;
+    }
+
+    stream->block[stream->count++] = value;
+    if (stream->count == RADAR_STREAM_COBS_BLOCK)
+    {
+        radar_stream_flush_block(stream);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_stream_crc
+ ********************************************************************************
+ * Summary:
+ *   Continues a CRC-16/CCITT-FALSE over more data. Start with
+ *   RADAR_STREAM_CRC_INIT.
+ *
+ * Parameters:
+ *   crc: CRC of the data so far
+ *   data: bytes to add
+ *   length: number of bytes
+ *
+ * Return:
+ *   CRC including the new bytes
+ *******************************************************************************/
+uint16_t radar_stream_crc(uint16_t crc, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)bytes[i] << 8);
+        for (uint32_t bit = 0; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1) ^ RADAR_STREAM_CRC_POLY) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+ * Function Name: radar_stream_begin
+ ********************************************************************************
+ * Summary:
+ *   Starts a record. A delimiter is written first, so that text written since
+ *   the last record is discarded by the host.
+ *
+ * Parameters:
+ *   stream: encoder state
+ *   type: record type
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_stream_begin(radar_stream_t *stream, uint8_t type)
+{
+    stream->crc = RADAR_STREAM_CRC_INIT;
+    stream->count = 0U;
+
+    radar_stream_putc(RADAR_STREAM_DELIMITER);
+    radar_stream_write(stream, &type, 1U);
+}
+
+/*******************************************************************************
+ * Function Name: radar_stream_write
+ ********************************************************************************
+ * Summary:
+ *   Appends data to the record and to its CRC.
+ *
+ * Parameters:
+ *   stream: encoder state
+ *   data: bytes to append
+ *   length: number of bytes
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_stream_write(radar_stream_t *stream, const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+
+    stream->crc = radar_stream_crc(stream->crc, data, length);
+    for (size_t i = 0; i < length; i++)
+    {
+        radar_stream_encode(stream, bytes[i]);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_stream_end
+ ********************************************************************************
+ * Summary:
+ *   Appends the CRC (most significant byte first) and ends the record with a
+ *   delimiter.
+ *
+ * Parameters:
+ *   stream: encoder state
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_stream_end(radar_stream_t *stream)
+{
+    uint16_t crc = stream->crc;
+
+    radar_stream_encode(stream, (uint8_t)(crc >> 8));
+    radar_stream_encode(stream, (uint8_t)crc);
+    radar_stream_flush_block(stream);
+    radar_stream_putc(RADAR_STREAM_DELIMITER);
+}
+
+/*******************************************************************************
+ * Function Name: radar_stream_send
+ ********************************************************************************
+ * Summary:
+ *   Writes a complete record with the given payload.
+ *
+ * Parameters:
+ *   type: record type
+ *   payload: record payload
+ *   length: payload size in bytes
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_stream_send(uint8_t type, const void *payload, size_t length)
+{
+    radar_stream_t stream;
+
+    radar_stream_begin(&stream, type);
+    radar_stream_write(&stream, payload, length);
+    radar_stream_end(&stream);
+}
@@ -0,0 +1,84 @@
+/******************************************************************************
+** File name: radar_stream.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_stream.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Largest COBS block: a code byte is followed by at most 254 non-zero bytes */
+#define RADAR_STREAM_COBS_BLOCK (254U)
+/* Initial value of the CRC-16/CCITT-FALSE of a record */
+#define RADAR_STREAM_CRC_INIT (0xFFFFU)
+
+/* Record types, first byte of every record */
+#define RADAR_STREAM_TYPE_EVENT (0x01U)
+#define RADAR_STREAM_TYPE_CAPTURE_PARAMS (0x02U)
+#define RADAR_STREAM_TYPE_CAPTURE_FRAME (0x03U)
+#define RADAR_STREAM_TYPE_TELEMETRY (0x04U)
+#define RADAR_STREAM_TYPE_LOAD (0x05U)
+
+/* Payload size of a RADAR_STREAM_TYPE_EVENT record */
+#define RADAR_STREAM_EVENT_SIZE (16U)
+/* Payload size of a RADAR_STREAM_TYPE_TELEMETRY record */
+#define RADAR_STREAM_TELEMETRY_SIZE (14U)
+/* Payload size of a RADAR_STREAM_TYPE_LOAD record */
+#define RADAR_STREAM_LOAD_SIZE (16U)
+/* Event codes of a RADAR_STREAM_TYPE_EVENT record */
+#define RADAR_STREAM_EVENT_PRESENCE_IN (0U)
+#define RADAR_STREAM_EVENT_PRESENCE_OUT (1U)
+#define RADAR_STREAM_EVENT_RATE_LOW (2U)
+#define RADAR_STREAM_EVENT_RATE_FULL (3U)
+#define RADAR_STREAM_EVENT_COUNTER_IN (4U)
+#define RADAR_STREAM_EVENT_COUNTER_OUT (5U)
+#define RADAR_STREAM_EVENT_COUNTER_OCCUPIED (6U)
+#define RADAR_STREAM_EVENT_COUNTER_FREE (7U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Encoder state of one record. A record is written with radar_stream_begin,
+   any number of radar_stream_write calls and radar_stream_end. Callers must
+   make sure that records are not interleaved. */
+typedef struct
+{
+    uint16_t crc;
+    uint8_t count;
+    uint8_t block[RADAR_STREAM_COBS_BLOCK];
+} radar_stream_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+uint16_t radar_stream_crc(uint16_t crc, const void *data, size_t length);
+void radar_stream_begin(radar_stream_t *stream, uint8_t type);
+void radar_stream_write(radar_stream_t *stream, const void *data, size_t length);
+void radar_stream_end(radar_stream_t *stream);
+void radar_stream_send(uint8_t type, const void *payload, size_t length);
@@ -0,0 +1,230 @@
+/*****************************************************************************
+** File name: radar_sweep.c
+**
+** Description: This file implements the parameter sweep of the radar presence
+** application. It applies every combination of a grid of presence ranges and
+** all sensitivities through the parameter queue of the radar task, lets the
+** radars process a number of frames with it and prints the processing cost,
+** the events and the CPU idle fraction of every setting.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file from system */
+#include <inttypes.h>
+#include <stdio.h>
+
+/* Header file includes */
+#include "cyabs_rtos.h"
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_adaptive.h"
+#include "radar_params.h"
+#include "radar_profiler.h"
+#include "radar_stats.h"
+#include "radar_sweep.h"
+#include "radar_task.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Presence ranges of the sweep in m, within the limits of the parameter table */
+static const float sweep_ranges[] = { 0.66f, 1.0f, 2.5f, 5.0f, 10.2f };
+
+/*******************************************************************************
+ * Function Name: radar_sweep_wait
+ ********************************************************************************
+ * Summary:
+ *   Waits until the radar task has processed the given number of frames
+ *   since the processing cost was reset.
+ *
+ * Parameters:
+ *   frames: frames to wait for
+ *   cost: receives the processing cost of the frames
+ *
+ * Return:
+ *   false if no frame was processed for RADAR_SWEEP_FRAME_TIMEOUT_MS
+ *******************************************************************************/
+static bool radar_sweep_wait(uint32_t frames, radar_task_cost_t *cost)
+{
+    uint32_t last_frames = 0;
+    uint32_t idle_ms = 0;
+
+    radar_task_get_cost(cost);
+    while (cost->frames < frames)
+    {
+        vTaskDelay(pdMS_TO_TICKS(RADAR_SWEEP_POLL_MS));
+        radar_task_get_cost(cost);
+
+        if (cost->frames != last_frames)
+        {
+            last_frames = cost->frames;
+            idle_ms = 0;
+        }
+        else if ((idle_ms += RADAR_SWEEP_POLL_MS) >= RADAR_SWEEP_FRAME_TIMEOUT_MS)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: radar_sweep_step
+ ********************************************************************************
+ * Summary:
+ *   Applies one setting, lets the radars process the given number of frames
+ *   with it and prints a row of the sweep table. The times in us cover the
+ *   same span as the cycles of RADAR_PROFILER_PROCESS: the process call and
+ *   its event callbacks, without the coalescing, load, capture and latency
+ *   work of the frame.
+ *
+ * Parameters:
+ *   range: presence range in m
+ *   sensitivity: index of the sensitivity in the parameter table
+ *   frames: frames to process with the setting
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_sweep_step(float range, uint32_t sensitivity, uint32_t frames)
+{
+    const radar_param_info_t *info = radar_params_get_info(RADAR_PARAM_SENSITIVITY);
+    const radar_task_param_t params[] =
+    {
+        { .id = RADAR_PARAM_RANGE_MAX, .value = { .number = range } },
+        { .id = RADAR_PARAM_SENSITIVITY, .value = { .choice = sensitivity } }
+    };
+    radar_task_cost_t cost;
+
+    if (radar_task_set_parameters(params, sizeof(params) / sizeof(params[0])) != MTB_RADAR_SENSING_SUCCESS)
+    {
+        radar_presence_task_set_mute(true);
+        printf("%5.2f %-7s parameters rejected\n", (double)range, info->choices[sensitivity]);
+        radar_presence_task_set_mute(false);
+        return;
+    }
+
+    /* Start all measurements at the first frame with the new setting */
+    radar_task_reset_cost();
+#if (RADAR_PROFILER_ENABLE == 1)
+    radar_profiler_reset();
+#endif
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+    uint32_t idle_start;
+    uint32_t total_start;
+    radar_stats_get_idle(&idle_start, &total_start);
+#endif
+
+    bool complete = radar_sweep_wait(frames, &cost);
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+    uint32_t idle_end;
+    uint32_t total_end;
+    radar_stats_get_idle(&idle_end, &total_end);
+#endif
+
+    /* The events flow between the rows, a row is printed in one piece */
+    radar_presence_task_set_mute(true);
+    printf("%5.2f %-7s", (double)range, info->choices[sensitivity]);
+    printf(" %6" PRIu32 " %7" PRIu32 " %7" PRIu32,
+           cost.frames,
+           (cost.frames != 0U) ? (uint32_t)(cost.total_us / cost.frames) : 0U,
+           cost.max_us);
+#if (RADAR_PROFILER_ENABLE == 1)
+    radar_profiler_stats_t process;
+    radar_profiler_get_stats(RADAR_PROFILER_PROCESS, &process);
+    printf(" %9" PRIu32 " %9" PRIu32,
+           (process.count != 0U) ? (uint32_t)(process.sum / process.count) : 0U,
+           process.max);
+#endif
+    printf(" %8" PRIu32 " %7" PRIu32, cost.presence_events, cost.counter_events);
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+    uint32_t total = total_end - total_start;
+    printf(" %5.1f%%", (total != 0U) ? ((double)(idle_end - idle_start) * 100.0 / (double)total) : 0.0);
+#endif
+    printf("%s\n", complete ? "" : " timeout");
+    radar_presence_task_set_mute(false);
+}
+
+/*******************************************************************************
+ * Function Name: radar_sweep_run
+ ********************************************************************************
+ * Summary:
+ *   Runs the parameter sweep and prints a table with a row per setting: the
+ *   frames, the mean and maximum time of mtb_radar_sensing_process(), with
+ *   RADAR_PROFILER=1 its mean and maximum in cycles, the events of both use
+ *   cases and, with RADAR_RUNTIME_STATS=1, the CPU idle fraction. Resets the
+ *   processing cost and the processing profile, and restores the parameters
+ *   at the end. The event output goes on between the rows. Called by the
+ *   terminal UI task, blocks until the sweep is done.
+ *
+ * Parameters:
+ *   frames: frames to process with every setting
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_sweep_run(uint32_t frames)
+{
+    const radar_param_info_t *info = radar_params_get_info(RADAR_PARAM_SENSITIVITY);
+    radar_param_value_t values[RADAR_PARAMS];
+    radar_adaptive_config_t adaptive;
+
+    /* The low frame rate would stop the radars in the middle of a setting */
+    radar_adaptive_get_config(&adaptive);
+    if (adaptive.idle_s != 0U)
+    {
+        printf("Turn the adaptive frame rate off first\n");
+        return;
+    }
+
+    radar_task_get_values(values);
+
+    radar_presence_task_set_mute(true);
+    printf("range sens    frames mean us  max us");
+#if (RADAR_PROFILER_ENABLE == 1)
+    printf("  mean cyc   max cyc");
+#endif
+    printf(" presence counter");
+#if (RADAR_RUNTIME_STATS_ENABLE == 1)
+    printf("   idle");
+#endif
+    printf("\n");
+    radar_presence_task_set_mute(false);
+
+    for (uint32_t i = 0; i < (sizeof(sweep_ranges) / sizeof(sweep_ranges[0])); i++)
+    {
+        for (uint32_t j = 0; j < info->choice_count; j++)
+        {
+            radar_sweep_step(sweep_ranges[i], j, frames);
+        }
+    }
+
+    const radar_task_param_t restore[] =
+    {
+        { .id = RADAR_PARAM_RANGE_MAX, .value = values[RADAR_PARAM_RANGE_MAX] },
+        { .id = RADAR_PARAM_SENSITIVITY, .value = values[RADAR_PARAM_SENSITIVITY] }
+    };
+    if (radar_task_set_parameters(restore, sizeof(restore) / sizeof(restore[0])) != MTB_RADAR_SENSING_SUCCESS)
+    {
+        printf("Parameters could not be restored\n");
+    }
+}
@@ -0,0 +1,45 @@
+/******************************************************************************
+** File name: radar_sweep.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_sweep.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Limits of the number of frames processed per setting */
+#define RADAR_SWEEP_MIN_FRAMES (10U)
+#define RADAR_SWEEP_MAX_FRAMES (1000U)
+/* A setting is given up if no frame is processed for this time */
+#define RADAR_SWEEP_FRAME_TIMEOUT_MS (2000U)
+/* Time between two checks of the frame count */
+#define RADAR_SWEEP_POLL_MS (50U)
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void radar_sweep_run(uint32_t frames);
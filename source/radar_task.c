@@ -25,13 +25,29 @@
 
 /* Header file from system */
 #include <inttypes.h>
+#include <string.h>
 
 /* Header file includes */
 #include "cy_retarget_io.h"
 #include "cyhal.h"
 
 /* Header file for local task */
+#include "radar_adaptive.h"
+#include "radar_boot.h"
+#include "radar_capture.h"
+#include "radar_coalesce.h"
+#include "radar_event_bus.h"
+#include "radar_event_log.h"
+#include "radar_latency.h"
+#include "radar_load.h"
+#include "radar_params.h"
+#include "radar_profile.h"
+#include "radar_profiler.h"
+#include "radar_rtos.h"
+#include "radar_spi_dma.h"
 #include "radar_task.h"
+#include "radar_telemetry.h"
+#include "radar_time.h"
 
 /*******************************************************************************
  * Macros
@@ -48,124 +64,931 @@
 #define LED_STATE_ON (1U)
 /* RADAR sensor SPI frequency */
 #define SPI_FREQUENCY (25000000UL)
+/* Interrupt priority of the radar IRQ line */
+#define RADAR_IRQ_PRIORITY (CYHAL_ISR_PRIORITY_DEFAULT)
+/* Longest time the radar task blocks without an IRQ edge before it checks the
+   IRQ line itself, in case an edge has been missed */
+#define RADAR_IRQ_TIMEOUT pdMS_TO_TICKS(100)
+/* Maximum number of frames processed back to back per IRQ notification */
+#define RADAR_IRQ_MAX_BURST (8U)
+/* Period of RADAR_TASK_PROCESS_MODE_PERIODIC in us */
+#define RADAR_PERIOD_US ((uint32_t)MTB_RADAR_SENSING_PROCESS_DELAY * portTICK_PERIOD_MS * 1000U)
+/* Number of events that may wait for the LED subscriber. The LED state is
+   built from the PRESENCE_IN and PRESENCE_OUT events of every sensor, so the
+   depth scales with the number of sensors to keep a sensor's last event from
+   being skipped behind the events of the others. */
+#define RADAR_LED_DEPTH (4U * RADAR_SENSOR_COUNT)
+
+/* The pins of further wingboards depend on the installation */
+#if (RADAR_SENSOR_COUNT > 1)
+#if !defined(RADAR_SENSOR1_SPI_CS) || !defined(RADAR_SENSOR1_RESET) || !defined(RADAR_SENSOR1_LDO_EN) || \
+    !defined(RADAR_SENSOR1_IRQ)
+#error "Define the RADAR_SENSOR1_* pins of the second wingboard in the Makefile"
+#endif
+#endif
+#if (RADAR_SENSOR_COUNT > 2)
+#if !defined(RADAR_SENSOR2_SPI_CS) || !defined(RADAR_SENSOR2_RESET) || !defined(RADAR_SENSOR2_LDO_EN) || \
+    !defined(RADAR_SENSOR2_IRQ)
+#error "Define the RADAR_SENSOR2_* pins of the third wingboard in the Makefile"
+#endif
+#endif
+
+/*******************************************************************************
+ * Types
+ ******************************************************************************/
+/* Parameter command executed by the radar task between two frames. A command
+   with an adaptive policy changes the policy, otherwise all parameters of the
+   command are written as one batch. */
+typedef struct
+{
+    const radar_adaptive_config_t *adaptive;
+    const radar_task_param_t *params;
+    uint32_t count;
+    mtb_radar_sensing_result_t result;
+} radar_task_param_cmd_t;
+
+/* Radar wingboard on the shared SPI bus, radar task only */
+typedef struct
+{
+    mtb_radar_sensing_context_t context;
+    mtb_radar_sensing_hw_cfg_t hw_cfg;
+    uint32_t index;
+    uint32_t frames;      /* Frames processed */
+    uint32_t max_wait_us; /* Longest time the sensor was ready while the bus served other sensors */
+    float distance;       /* Distance of the last PRESENCE_IN event in m, for the telemetry */
+    float accuracy;       /* Accuracy of the last PRESENCE_IN event in m */
+} radar_sensor_t;
+
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_PERIODIC)
+/* Deadline statistics of the periodic processing, written by the radar task */
+typedef struct
+{
+    uint32_t periods;     /* Periods processed */
+    uint32_t overruns;    /* Periods that ended after their deadline */
+    uint32_t missed;      /* Period starts skipped because of overruns */
+    uint32_t max_late_us; /* Worst time past a deadline */
+} radar_task_period_stats_t;
+#endif
 
 /*******************************************************************************
  * Global Variables
  ******************************************************************************/
-mtb_radar_sensing_context_t sensing_context;
-static cy_mutex_t terminal_print_mutex;
+/* SPI bus shared by all sensors, each sensor has its own CS line */
+static cyhal_spi_t radar_spi;
+
+static radar_sensor_t sensors[RADAR_SENSOR_COUNT];
+
+/* Pins of the sensors, the first wingboard is connected as on the kit */
+static const mtb_radar_sensing_hw_cfg_t sensor_pins[RADAR_SENSOR_COUNT] =
+{
+    {
+        .spi_cs = CYBSP_SPI_CS,
+        .reset = CYBSP_GPIO11,
+        .ldo_en = CYBSP_GPIO5,
+        .irq = CYBSP_GPIO10,
+        .spi = &radar_spi
+    },
+#if (RADAR_SENSOR_COUNT > 1)
+    {
+        .spi_cs = RADAR_SENSOR1_SPI_CS,
+        .reset = RADAR_SENSOR1_RESET,
+        .ldo_en = RADAR_SENSOR1_LDO_EN,
+        .irq = RADAR_SENSOR1_IRQ,
+        .spi = &radar_spi
+    },
+#endif
+#if (RADAR_SENSOR_COUNT > 2)
+    {
+        .spi_cs = RADAR_SENSOR2_SPI_CS,
+        .reset = RADAR_SENSOR2_RESET,
+        .ldo_en = RADAR_SENSOR2_LDO_EN,
+        .irq = RADAR_SENSOR2_IRQ,
+        .spi = &radar_spi
+    },
+#endif
+};
+
+/* Time of the frame being processed in us, the timestamp of its events */
+static uint64_t frame_time_us;
+/* Bit per sensor that currently detects presence, radar task only */
+static uint32_t sensor_presence;
+/* Bit per sensor whose entrance counter reports an occupied room */
+static uint32_t sensor_occupied;
+static radar_task_cost_t process_cost;
+/* The contexts are enabled, false while the adaptive frame rate stops the
+   radars */
+static bool radar_running = true;
+
+/* The LEDs follow the events on the event bus */
+static radar_event_bus_subscriber_t led_subscriber;
+/* Bit per sensor that currently detects presence, LED subscriber only */
+static uint32_t led_presence;
+
+/* Parameter commands are queued by pointer. Callers are serialized by
+   param_cmd_mutex and wait on param_cmd_done until the radar task has
+   executed their command. */
+static QueueHandle_t param_cmd_queue;
+static SemaphoreHandle_t param_cmd_mutex;
+static SemaphoreHandle_t param_cmd_done;
+#if (RADAR_STATIC_MEMORY_ENABLE == 1)
+static uint8_t param_cmd_queue_items[RADAR_TASK_PARAM_QUEUE_LENGTH * sizeof(radar_task_param_cmd_t *)];
+static StaticQueue_t param_cmd_queue_storage;
+static StaticSemaphore_t param_cmd_mutex_storage;
+static StaticSemaphore_t param_cmd_done_storage;
+#endif
+
+/* Parameter values all sensors run with, written by the radar task */
+static radar_param_value_t param_values[RADAR_PARAMS];
+static TaskHandle_t radar_task_handle;
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_PERIODIC)
+static radar_task_period_stats_t period_stats;
+#endif
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_IRQ)
+/* Bit per sensor with an IRQ edge not yet served */
+static volatile uint32_t sensor_pending;
+#endif
+
+/*******************************************************************************
+ * Function Name: radar_led_handler
+ ********************************************************************************
+ * Summary:
+ *   Event bus subscriber that shows presence in front of any sensor with the
+ *   red LED and absence with the green LED. Called by the event bus
+ *   dispatcher task.
+ *
+ * Parameters:
+ *   record: event
+ *   dropped: not used
+ *   arg: not used
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_led_handler(const radar_event_record_t *record, const radar_event_bus_dropped_t *dropped, void *arg)
+{
+    switch (record->event)
+    {
+        case RADAR_EVENT_PRESENCE_IN:
+            led_presence |= (1UL << record->sensor);
+            break;
+        case RADAR_EVENT_PRESENCE_OUT:
+            led_presence &= ~(1UL << record->sensor);
+            break;
+        default:
+            break;
+    }
+
+    cyhal_gpio_write(LED_RGB_RED, (led_presence != 0U) ? LED_STATE_ON : LED_STATE_OFF);
+    cyhal_gpio_write(LED_RGB_GREEN, (led_presence != 0U) ? LED_STATE_OFF : LED_STATE_ON);
+
+#if (RADAR_LATENCY_ENABLE == 1)
+    radar_latency_event_mark(record->trace, RADAR_LATENCY_LED);
+#endif
+}
+
+/*******************************************************************************
+ * Function Name: radar_sensing_callback
+ ********************************************************************************
+ * Summary:
+ *   Callback function that handles the presence detection and entrance
+ *   counter events of all enabled use cases. The events are published on the
+ *   event bus, whose subscribers drive the LEDs and the console from their
+ *   own tasks.
+ *
+ * Parameters:
+ *   instance: context object of RadarSensing
+ *   event: types of events that are detected
+ *   event_info: description of the event
+ *   data: sensor of the context
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_sensing_callback(mtb_radar_sensing_context_t *context,
+                                   mtb_radar_sensing_event_t event,
+                                   mtb_radar_sensing_event_info_t *event_info,
+                                   void *data)
+{
+    RADAR_PROFILER_START(start);
+
+#if (RADAR_LATENCY_ENABLE == 1)
+    radar_latency_mark(RADAR_LATENCY_CALLBACK);
+#endif
+
+    radar_sensor_t *sensor = (radar_sensor_t *)data;
+    radar_event_record_t record =
+    {
+        .timestamp_us = frame_time_us,
+        .sensor = (uint8_t)sensor->index
+    };
+    bool publish = true;
+
+    switch (event)
+    {
+        case MTB_RADAR_SENSING_EVENT_PRESENCE_IN:
+            record.event = RADAR_EVENT_PRESENCE_IN;
+            record.distance = ((mtb_radar_sensing_presence_event_info_t *)event_info)->distance;
+            record.accuracy = ((mtb_radar_sensing_presence_event_info_t *)event_info)->accuracy;
+            sensor->distance = record.distance;
+            sensor->accuracy = record.accuracy;
+            sensor_presence |= (1UL << sensor->index);
+            break;
+        case MTB_RADAR_SENSING_EVENT_PRESENCE_OUT:
+            record.event = RADAR_EVENT_PRESENCE_OUT;
+            sensor_presence &= ~(1UL << sensor->index);
+            break;
+        case MTB_RADAR_SENSING_EVENT_COUNTER_IN:
+            record.event = RADAR_EVENT_COUNTER_IN;
+            break;
+        case MTB_RADAR_SENSING_EVENT_COUNTER_OUT:
+            record.event = RADAR_EVENT_COUNTER_OUT;
+            break;
+        case MTB_RADAR_SENSING_EVENT_COUNTER_OCCUPIED:
+            record.event = RADAR_EVENT_COUNTER_OCCUPIED;
+            sensor_occupied |= (1UL << sensor->index);
+            break;
+        case MTB_RADAR_SENSING_EVENT_COUNTER_FREE:
+            record.event = RADAR_EVENT_COUNTER_FREE;
+            sensor_occupied &= ~(1UL << sensor->index);
+            break;
+        default:
+            publish = false;
+            break;
+    }
+
+    /* LEDs and printing are deferred to the subscribers */
+    if (publish)
+    {
+        radar_boot_mark(RADAR_BOOT_FIRST_EVENT);
+        if ((record.event == RADAR_EVENT_PRESENCE_IN) || (record.event == RADAR_EVENT_PRESENCE_OUT))
+        {
+            process_cost.presence_events++;
+        }
+        else
+        {
+            /* All counter events carry the counts */
+            const mtb_radar_sensing_counter_event_info_t *info =
+                (const mtb_radar_sensing_counter_event_info_t *)event_info;
+            record.in_count = info->in_count;
+            record.out_count = info->out_count;
+            process_cost.counter_events++;
+        }
+
+        /* An occupied room keeps the full frame rate like a present target */
+        radar_adaptive_activity((sensor_presence | sensor_occupied) != 0U, frame_time_us / 1000U);
+        /* Presence flaps within the hold time are not published */
+        if (radar_coalesce_filter(&record))
+        {
+#if (RADAR_LATENCY_ENABLE == 1)
+            record.trace = radar_latency_publish();
+#endif
+            radar_event_bus_publish(&record);
+        }
+    }
+
+    RADAR_PROFILER_STOP(RADAR_PROFILER_CALLBACK, start);
+}
+
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_IRQ)
+/*******************************************************************************
+ * Function Name: radar_irq_handler
+ ********************************************************************************
+ * Summary:
+ *   Interrupt handler of the radar IRQ lines. Marks the sensor as ready and
+ *   wakes up the radar task with a direct-to-task notification. The handlers
+ *   of all sensors have the same priority and do not preempt each other.
+ *
+ * Parameters:
+ *   callback_arg: index of the sensor
+ *   event: GPIO event that triggered the interrupt
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_irq_handler(void *callback_arg, cyhal_gpio_event_t event)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    uint32_t sensor = (uint32_t)(uintptr_t)callback_arg;
+
+#if (RADAR_LATENCY_ENABLE == 1)
+    radar_latency_irq(sensor);
+#endif
+    sensor_pending |= (1UL << sensor);
+    vTaskNotifyGiveFromISR(radar_task_handle, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+#endif
+
+/*******************************************************************************
+ * Function Name: radar_task_keep_values
+ ********************************************************************************
+ * Summary:
+ *   Keeps the values of a batch that all sensors have accepted, for
+ *   radar_task_get_values.
+ *
+ * Parameters:
+ *   params: parameters written
+ *   count: number of parameters
+ *   result: result of writing them
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_task_keep_values(const radar_task_param_t *params, uint32_t count,
+                                   mtb_radar_sensing_result_t result)
+{
+    if (result != MTB_RADAR_SENSING_SUCCESS)
+    {
+        return;
+    }
+
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        param_values[params[i].id] = params[i].value;
+    }
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_apply_to_sensor
+ ********************************************************************************
+ * Summary:
+ *   Writes a batch of parameters to one sensor. A batch of more than one
+ *   parameter is written with the context disabled, so that the radar device
+ *   is reconfigured once when the context is enabled again instead of once
+ *   per parameter. While the adaptive frame rate has stopped the radars, the
+ *   device is reconfigured when it is started again.
+ *
+ * Parameters:
+ *   context: context object of the sensor
+ *   params: parameters to write
+ *   count: number of parameters
+ *
+ * Return:
+ *   MTB_RADAR_SENSING_SUCCESS if all parameters were written, otherwise the
+ *   first error
+ *******************************************************************************/
+static mtb_radar_sensing_result_t radar_task_apply_to_sensor(mtb_radar_sensing_context_t *context,
+                                                             const radar_task_param_t *params,
+                                                             uint32_t count)
+{
+    mtb_radar_sensing_result_t result = MTB_RADAR_SENSING_SUCCESS;
+    bool batch = (count > 1U) && radar_running;
+
+    if (batch)
+    {
+        result = mtb_radar_sensing_disable(context);
+    }
+
+    for (uint32_t i = 0; (i < count) && (result == MTB_RADAR_SENSING_SUCCESS); i++)
+    {
+        /* The library only takes strings, the values are converted here */
+        char value[RADAR_PARAMS_VALUE_MAXLENGTH];
+        radar_params_format(params[i].id, params[i].value, value, sizeof(value));
+        result = mtb_radar_sensing_set_parameter(context, radar_params_get_info(params[i].id)->key, value);
+    }
+
+    if (batch)
+    {
+        /* Always re-enable, even if one of the parameters was rejected */
+        if (mtb_radar_sensing_enable(context) != MTB_RADAR_SENSING_SUCCESS)
+        {
+            CY_ASSERT(0);
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_apply_parameters
+ ********************************************************************************
+ * Summary:
+ *   Writes a batch of parameters to all sensors, which always run with the
+ *   same parameters, and keeps their values. Stops at the first sensor that
+ *   rejects a parameter. Must only be called by the radar task.
+ *
+ * Parameters:
+ *   params: parameters to write
+ *   count: number of parameters
+ *
+ * Return:
+ *   MTB_RADAR_SENSING_SUCCESS if all parameters were written, otherwise the
+ *   first error
+ *******************************************************************************/
+static mtb_radar_sensing_result_t radar_task_apply_parameters(const radar_task_param_t *params, uint32_t count)
+{
+    mtb_radar_sensing_result_t result = MTB_RADAR_SENSING_SUCCESS;
+
+    for (uint32_t i = 0; (i < RADAR_SENSOR_COUNT) && (result == MTB_RADAR_SENSING_SUCCESS); i++)
+    {
+        result = radar_task_apply_to_sensor(&sensors[i].context, params, count);
+    }
+    radar_task_keep_values(params, count, result);
+
+#if (RADAR_CAPTURE_ENABLE == 1)
+    /* Frames captured from now on are preceded by the new parameter set */
+    radar_capture_parameters_changed();
+#endif
+
+    return result;
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_run_commands
+ ********************************************************************************
+ * Summary:
+ *   Executes all parameter commands that are waiting in the queue. Called by
+ *   the radar task between two frames, so that parameters never change while
+ *   mtb_radar_sensing_process() is running.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_task_run_commands(void)
+{
+    radar_task_param_cmd_t *cmd;
+
+    while (xQueueReceive(param_cmd_queue, &cmd, 0) == pdTRUE)
+    {
+        if (cmd->adaptive != NULL)
+        {
+            cmd->result = radar_adaptive_set_config(cmd->adaptive) ? MTB_RADAR_SENSING_SUCCESS :
+                                                                     MTB_RADAR_SENSING_ERROR;
+        }
+        else
+        {
+            cmd->result = radar_task_apply_parameters(cmd->params, cmd->count);
+        }
+        (void)xSemaphoreGive(param_cmd_done);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_submit
+ ********************************************************************************
+ * Summary:
+ *   Queues a parameter command for the radar task and waits until it has been
+ *   executed. Must not be called by the radar task itself.
+ *
+ * Parameters:
+ *   cmd: parameter command
+ *
+ * Return:
+ *   result of the command
+ *******************************************************************************/
+static mtb_radar_sensing_result_t radar_task_submit(radar_task_param_cmd_t *cmd)
+{
+    (void)xSemaphoreTakeRecursive(param_cmd_mutex, portMAX_DELAY);
+    if (xQueueSend(param_cmd_queue, &cmd, portMAX_DELAY) == pdTRUE)
+    {
+        /* Wake up the radar task, which may wait for a long time while the
+           adaptive frame rate has stopped the radars */
+        xTaskNotifyGive(radar_task_handle);
+        (void)xSemaphoreTake(param_cmd_done, portMAX_DELAY);
+    }
+    else
+    {
+        cmd->result = MTB_RADAR_SENSING_ERROR;
+    }
+    (void)xSemaphoreGiveRecursive(param_cmd_mutex);
+
+    return cmd->result;
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_process
+ ********************************************************************************
+ * Summary:
+ *   Processes data acquired from one sensor
+ *
+ * Parameters:
+ *   sensor: sensor to read
+ *   ready_us: time since when the sensor is waiting for the bus
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_task_process(radar_sensor_t *sensor, uint64_t ready_us)
+{
+    /* The library works in ms, the events keep the time in us */
+    frame_time_us = radar_time_us();
+    uint64_t time_ms = frame_time_us / 1000U;
+
+    uint32_t wait_us = (uint32_t)(frame_time_us - ready_us);
+    if (wait_us > sensor->max_wait_us)
+    {
+        sensor->max_wait_us = wait_us;
+    }
+
+    /* Presence out events held back by the coalescing */
+    radar_coalesce_poll(frame_time_us);
+#if (RADAR_LOAD_ENABLE == 1)
+    radar_load_frame(frame_time_us);
+#endif
+
+#if (RADAR_CAPTURE_ENABLE == 1)
+    /* Only the frames of the first sensor are captured */
+    bool capture = (sensor->index == 0U);
+    if (capture)
+    {
+        radar_capture_frame_begin(time_ms);
+    }
+#endif
+
+#if (RADAR_LATENCY_ENABLE == 1)
+    radar_latency_frame_begin(sensor->index);
+#endif
+
+    /* The cost covers the process call only, not the bookkeeping above */
+    uint64_t process_start_us = radar_time_us();
+    RADAR_PROFILER_START(start);
+    mtb_radar_sensing_result_t result = mtb_radar_sensing_process(&sensor->context, time_ms);
+    RADAR_PROFILER_STOP(RADAR_PROFILER_PROCESS, start);
+
+    /* All enabled use cases run in the same process call */
+    uint32_t process_us = (uint32_t)(radar_time_us() - process_start_us);
+    process_cost.frames++;
+    process_cost.total_us += process_us;
+    if (process_us > process_cost.max_us)
+    {
+        process_cost.max_us = process_us;
+    }
+
+#if (RADAR_LATENCY_ENABLE == 1)
+    radar_latency_frame_end();
+#endif
+
+#if (RADAR_CAPTURE_ENABLE == 1)
+    if (capture)
+    {
+        radar_capture_frame_end();
+    }
+#endif
+
+    sensor->frames++;
+
+    /* The library reports the distance only when a target enters, the */
+    /* telemetry reports the last one of an interval with presence     */
+    radar_telemetry_sample(sensor->index,
+                           (sensor_presence & (1UL << sensor->index)) != 0U,
+                           sensor->distance,
+                           sensor->accuracy,
+                           frame_time_us);
+
+    if (result != MTB_RADAR_SENSING_SUCCESS)
+    {
+        printf("ifx_radar_sensing_process error\n");
+        CY_ASSERT(0);
+    }
+    radar_boot_mark(RADAR_BOOT_FIRST_FRAME);
+
+    /* Frame boundary: apply pending parameter changes */
+    radar_task_run_commands();
+}
+
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_PERIODIC)
+/*******************************************************************************
+ * Function Name: radar_task_end_period
+ ********************************************************************************
+ * Summary:
+ *   Checks the end of a period against its deadline, the start of the next
+ *   period, and blocks until the next period starts. After an overrun the
+ *   period starts that have passed are skipped instead of processed back to
+ *   back, so that the schedule keeps its phase and the radar task does not
+ *   starve the lower priority tasks.
+ *
+ * Parameters:
+ *   last_wake: start of the current period in ticks, updated to the next one
+ *   deadline_us: deadline of the current period, updated to the next one
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_task_end_period(TickType_t *last_wake, uint64_t *deadline_us)
+{
+    uint64_t now_us = radar_time_us();
+
+    period_stats.periods++;
+    if (now_us >= *deadline_us)
+    {
+        uint32_t late_us = (uint32_t)(now_us - *deadline_us);
+        uint32_t skipped = (late_us / RADAR_PERIOD_US) + 1U;
+
+        period_stats.overruns++;
+        period_stats.missed += skipped;
+        if (late_us > period_stats.max_late_us)
+        {
+            period_stats.max_late_us = late_us;
+        }
+        *last_wake += (TickType_t)(skipped * MTB_RADAR_SENSING_PROCESS_DELAY);
+        *deadline_us += (uint64_t)skipped * RADAR_PERIOD_US;
+    }
+
+    *deadline_us += RADAR_PERIOD_US;
+    vTaskDelayUntil(last_wake, MTB_RADAR_SENSING_PROCESS_DELAY);
+}
+#endif
+
+/*******************************************************************************
+ * Function Name: radar_task_init_pins
+ ********************************************************************************
+ * Summary:
+ *   Initializes the reset, LDO, IRQ and CS pins of a sensor. Must be done for
+ *   all sensors before the shared SPI bus is used, so that every CS line is
+ *   inactive. The IRQ events are enabled by the radar task, which they
+ *   notify.
+ *
+ * Parameters:
+ *   sensor: sensor to initialize
+ *   index: index of the sensor
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_task_init_pins(radar_sensor_t *sensor, uint32_t index)
+{
+    sensor->index = index;
+    sensor->hw_cfg = sensor_pins[index];
+
+    /* Activate radar reset pin */
+    cyhal_gpio_init(sensor->hw_cfg.reset, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, true);
+
+    /* Enable LDO */
+    cyhal_gpio_init(sensor->hw_cfg.ldo_en, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, true);
+
+    /* Enable IRQ pin */
+    cyhal_gpio_init(sensor->hw_cfg.irq, CYHAL_GPIO_DIR_INPUT, CYHAL_GPIO_DRIVE_PULLDOWN, false);
+
+    /* CS handled manually */
+    cyhal_gpio_init(sensor->hw_cfg.spi_cs, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, true);
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_init
+ ********************************************************************************
+ * Summary:
+ *   Initializes the parameter command queue, subscribes the LEDs to the
+ *   event bus and powers up the sensors, so that their LDOs settle while the
+ *   scheduler and the other tasks start. Must be called before the scheduler
+ *   is started.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_task_init(void)
+{
+    if (radar_rtos_init_queue(&param_cmd_queue,
+                              RADAR_TASK_PARAM_QUEUE_LENGTH,
+                              sizeof(radar_task_param_cmd_t *),
+                              RADAR_RTOS_QUEUE_MEMORY(param_cmd_queue)) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (radar_rtos_init_mutex(&param_cmd_mutex, RADAR_RTOS_OBJECT_MEMORY(param_cmd_mutex)) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (radar_rtos_init_binary_semaphore(&param_cmd_done, RADAR_RTOS_OBJECT_MEMORY(param_cmd_done)) !=
+        CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    radar_event_bus_subscribe(&led_subscriber, "LED", RADAR_LED_DEPTH, radar_led_handler, NULL);
+
+    for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
+    {
+        radar_task_init_pins(&sensors[i], i);
+    }
+    radar_boot_mark(RADAR_BOOT_RADAR_POWER);
+}
 
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_IRQ)
 /*******************************************************************************
- * Function Name: radar_presence_terminal_mutex_get
+ * Function Name: radar_task_ready_sensors
  ********************************************************************************
  * Summary:
- *   Get mutex
+ *   Returns the sensors with FIFO data: those with an IRQ edge since the last
+ *   call, and those whose IRQ line is still set. No new edge arrives while a
+ *   FIFO stays above its threshold, so the line is read as well. No sensor is
+ *   ready while the adaptive frame rate has stopped the radars.
  *
  * Parameters:
- *   timeout_ms: Maximum number of milliseconds to wait while attempting to
- *   get mutex
+ *   none
  *
  * Return:
- *   Status of mutex request
+ *   bit mask of the ready sensors
  *******************************************************************************/
-static cy_rslt_t radar_presence_terminal_mutex_get(cy_time_t timeout_ms)
+static uint32_t radar_task_ready_sensors(void)
 {
-    return (cy_rtos_get_mutex(&terminal_print_mutex, timeout_ms));
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    uint32_t ready = sensor_pending;
+    sensor_pending = 0U;
+    Cy_SysLib_ExitCriticalSection(status);
+
+    if (!radar_running)
+    {
+        return 0U;
+    }
+
+    for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
+    {
+        if (cyhal_gpio_read(sensors[i].hw_cfg.irq))
+        {
+            ready |= (1UL << i);
+        }
+    }
+
+    return ready;
 }
+#endif
 
 /*******************************************************************************
- * Function Name: radar_presence_terminal_mutex_release
+ * Function Name: radar_task_adapt
  ********************************************************************************
  * Summary:
- *  Set mutex
+ *   Advances the adaptive frame rate. Stops or starts the radars when the
+ *   policy moves between a running and a stopped phase, and publishes the
+ *   switches between the full and the low rate on the event bus.
  *
  * Parameters:
  *   none
  *
  * Return:
- *   Status of mutex request
+ *   ticks until the policy must be advanced again
  *******************************************************************************/
-static cy_rslt_t radar_presence_terminal_mutex_release(void)
+static TickType_t radar_task_adapt(void)
 {
-    return (cy_rtos_set_mutex(&terminal_print_mutex));
+    radar_adaptive_state_t previous = radar_adaptive_get_state();
+    uint32_t wait_ms;
+
+    if (radar_adaptive_update(radar_time_ms(), &wait_ms))
+    {
+        radar_adaptive_state_t state = radar_adaptive_get_state();
+        bool running = (state != RADAR_ADAPTIVE_LOW_OFF);
+
+        if (running != radar_running)
+        {
+            for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
+            {
+                mtb_radar_sensing_result_t result = running ? mtb_radar_sensing_enable(&sensors[i].context) :
+                                                              mtb_radar_sensing_disable(&sensors[i].context);
+                if (result != MTB_RADAR_SENSING_SUCCESS)
+                {
+                    CY_ASSERT(0);
+                }
+            }
+            radar_running = running;
+        }
+
+        if ((previous == RADAR_ADAPTIVE_FULL) || (state == RADAR_ADAPTIVE_FULL))
+        {
+            radar_event_record_t record =
+            {
+                .timestamp_us = radar_time_us(),
+                .event = (state == RADAR_ADAPTIVE_FULL) ? RADAR_EVENT_RATE_FULL : RADAR_EVENT_RATE_LOW
+            };
+#if (RADAR_LATENCY_ENABLE == 1)
+            record.trace = RADAR_LATENCY_NO_TRACE;
+#endif
+            radar_event_bus_publish(&record);
+        }
+    }
+
+    /* One tick more, so that the deadline has passed when the task wakes up */
+    return (wait_ms > (RADAR_ADAPTIVE_MAX_IDLE_S * 1000U)) ? portMAX_DELAY : (pdMS_TO_TICKS(wait_ms) + 1U);
 }
 
 /*******************************************************************************
- * Function Name: radar_sensing_callback
+ * Function Name: radar_task_init_sensor
  ********************************************************************************
  * Summary:
- *   Callback function that handles presence detection events
+ *   Initializes the RadarSensing context object of a sensor for the use cases
+ *   of RADAR_TASK_MODES, which also configures the radar device, and
+ *   registers the event callback. All use cases are served from the same
+ *   frames and report through the same callback.
  *
  * Parameters:
- *   instance: context object of RadarSensing
- *   event: types of events that are detected
- *   event_info: description of the event
- *   data:
+ *   sensor: sensor to initialize
  *
  * Return:
  *   none
  *******************************************************************************/
-static void radar_sensing_callback(mtb_radar_sensing_context_t *context,
-                                   mtb_radar_sensing_event_t event,
-                                   mtb_radar_sensing_event_info_t *event_info,
-                                   void *data)
+static void radar_task_init_sensor(radar_sensor_t *sensor)
 {
-    switch (event)
+    if (mtb_radar_sensing_init(&sensor->context, &sensor->hw_cfg, RADAR_TASK_MODES) != MTB_RADAR_SENSING_SUCCESS)
     {
-        case MTB_RADAR_SENSING_EVENT_PRESENCE_IN:
-            cyhal_gpio_write(LED_RGB_RED, LED_STATE_ON);
-            cyhal_gpio_write(LED_RGB_GREEN, LED_STATE_OFF);
-            if (radar_presence_terminal_mutex_get(0) == CY_RSLT_SUCCESS)
-            {
-                printf("%.3f: Presence IN %.2f-%.2f\n",
-                       (float)event_info->timestamp / 1000,
-                       ((mtb_radar_sensing_presence_event_info_t *)event_info)->distance -
-                           ((mtb_radar_sensing_presence_event_info_t *)event_info)->accuracy,
-                       ((mtb_radar_sensing_presence_event_info_t *)event_info)->distance +
-                           ((mtb_radar_sensing_presence_event_info_t *)event_info)->accuracy);
-                radar_presence_terminal_mutex_release();
-            }
-            break;
-        case MTB_RADAR_SENSING_EVENT_PRESENCE_OUT:
-            cyhal_gpio_write(LED_RGB_RED, LED_STATE_OFF);
-            cyhal_gpio_write(LED_RGB_GREEN, LED_STATE_ON);
-            if (radar_presence_terminal_mutex_get(0) == CY_RSLT_SUCCESS)
-            {
-                printf("%.3f: Presence OUT\n", (float)event_info->timestamp / 1000);
-                radar_presence_terminal_mutex_release();
-            }
-            break;
-        default:
-            break;
+        printf("ifx_radar_sensing_init error - Radar Wingboard %u not connected?\n", (unsigned int)sensor->index);
+        CY_ASSERT(0);
+    }
+
+    /* Register callback to handle presence detection events */
+    if (mtb_radar_sensing_register_callback(&sensor->context, radar_sensing_callback, sensor) !=
+        MTB_RADAR_SENSING_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_set_initial_parameters
+ ********************************************************************************
+ * Summary:
+ *   Sets the parameters of all sensors before their contexts are enabled, so
+ *   that every radar device is configured once with all of them.
+ *
+ * Parameters:
+ *   params: parameters to write
+ *   count: number of parameters
+ *
+ * Return:
+ *   MTB_RADAR_SENSING_SUCCESS if all parameters were written, otherwise the
+ *   first error
+ *******************************************************************************/
+static mtb_radar_sensing_result_t radar_task_set_initial_parameters(const radar_task_param_t *params, uint32_t count)
+{
+    mtb_radar_sensing_result_t result = MTB_RADAR_SENSING_SUCCESS;
+
+    for (uint32_t i = 0; (i < RADAR_SENSOR_COUNT) && (result == MTB_RADAR_SENSING_SUCCESS); i++)
+    {
+        for (uint32_t j = 0; (j < count) && (result == MTB_RADAR_SENSING_SUCCESS); j++)
+        {
+            char value[RADAR_PARAMS_VALUE_MAXLENGTH];
+            radar_params_format(params[j].id, params[j].value, value, sizeof(value));
+            result = mtb_radar_sensing_set_parameter(&sensors[i].context, radar_params_get_info(params[j].id)->key,
+                                                     value);
+        }
     }
+    radar_task_keep_values(params, count, result);
+
+    return result;
 }
 
 /*******************************************************************************
- * Function Name: ifx_currenttime
+ * Function Name: radar_task_restore
  ********************************************************************************
  * Summary:
- *   Obtains system time in ms
+ *   Applies the saved profile to all sensors, read in place from flash, or
+ *   the default parameters if no valid profile is saved or the library
+ *   rejects one of its values.
  *
  * Parameters:
  *   none
  *
  * Return:
- *   system time in ms
+ *   none
  *******************************************************************************/
-static uint64_t ifx_currenttime()
+static void radar_task_restore(void)
 {
-    return (uint64_t)xTaskGetTickCount() * portTICK_PERIOD_MS;
+    const radar_profile_t *profile = radar_profile_load();
+
+    if (profile != NULL)
+    {
+        radar_task_param_t params[RADAR_PROFILE_PARAMS];
+        uint32_t count = radar_profile_get_params(profile, params);
+
+        if ((radar_task_set_initial_parameters(params, count) == MTB_RADAR_SENSING_SUCCESS) &&
+            radar_adaptive_set_config(&profile->adaptive))
+        {
+            return;
+        }
+        printf("Saved profile rejected, using the default parameters\n");
+    }
+
+    radar_task_param_t defaults[RADAR_PARAMS];
+    for (uint32_t i = 0; i < (uint32_t)RADAR_PARAMS; i++)
+    {
+        defaults[i].id = (radar_param_id_t)i;
+        defaults[i].value = radar_params_get_info((radar_param_id_t)i)->default_value;
+    }
+
+    if (radar_task_set_initial_parameters(defaults, RADAR_PARAMS) != MTB_RADAR_SENSING_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
 }
 
 /*******************************************************************************
  * Function Name: radar_task
  ********************************************************************************
  * Summary:
- *   Initializes mutex for terminal print, LED ports, context object of
- *   RadarSensing for presence detection, then initializes radar device
- *   configuration, sets parameters for presence detection, registers
- *   callback to handle presence detection events and continuously processes
- *   data acquired from radar.
+ *   Initializes LED ports, the shared SPI bus and the context objects of
+ *   RadarSensing for presence detection of all sensors, then continuously
+ *   processes the data acquired from the sensors, either whenever the IRQ
+ *   line of a sensor signals that its FIFO has data, at a fixed polling
+ *   interval or at a fixed period with deadline tracking. The sensors with
+ *   data are served round robin, one frame per sensor at a time, so that no
+ *   sensor waits for the FIFO of another one to be drained.
  *
  * Parameters:
  *   arg: thread
@@ -175,15 +998,11 @@ static uint64_t ifx_currenttime()
  *******************************************************************************/
 void radar_task(cy_thread_arg_t arg)
 {
-    /* Initialize mutex for terminal print */
-    cy_rslt_t result = cy_rtos_init_mutex(&terminal_print_mutex);
-    if (result != CY_RSLT_SUCCESS)
-    {
-        CY_ASSERT(0);
-    }
+    radar_task_handle = xTaskGetCurrentTaskHandle();
+    radar_boot_mark(RADAR_BOOT_SCHEDULER);
 
     /* Initialize the three LED ports and set LEDs' initial state to off */
-    result = cyhal_gpio_init(LED_RGB_RED, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, LED_STATE_OFF);
+    cy_rslt_t result = cyhal_gpio_init(LED_RGB_RED, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, LED_STATE_OFF);
     if (result != CY_RSLT_SUCCESS)
     {
         CY_ASSERT(0);
@@ -201,85 +1020,232 @@ void radar_task(cy_thread_arg_t arg)
         CY_ASSERT(0);
     }
 
-    cyhal_spi_t mSPI;
-
-    mtb_radar_sensing_hw_cfg_t hw_cfg =
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_IRQ)
+    /* Notify the radar task on every rising edge of the IRQ pins */
+    for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
     {
-        .spi_cs = CYBSP_SPI_CS,
-        .reset = CYBSP_GPIO11,
-        .ldo_en = CYBSP_GPIO5,
-        .irq = CYBSP_GPIO10,
-        .spi = &mSPI
-    };
-
-    /* Activate radar reset pin */
-    cyhal_gpio_init(hw_cfg.reset, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, true);
-
-    /* Enable LDO */
-    cyhal_gpio_init(hw_cfg.ldo_en, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, true);
-
-    /* Enable IRQ pin */
-    cyhal_gpio_init(hw_cfg.irq, CYHAL_GPIO_DIR_INPUT, CYHAL_GPIO_DRIVE_PULLDOWN, false);
-
-    /* CS handled manually */
-    cyhal_gpio_init(hw_cfg.spi_cs, CYHAL_GPIO_DIR_OUTPUT, CYHAL_GPIO_DRIVE_STRONG, true);
+        cyhal_gpio_register_callback(sensors[i].hw_cfg.irq, radar_irq_handler, (void *)(uintptr_t)i);
+        cyhal_gpio_enable_event(sensors[i].hw_cfg.irq, CYHAL_GPIO_IRQ_RISE, RADAR_IRQ_PRIORITY, true);
+    }
+#endif
 
     /* Configure SPI interface */
-    if (cyhal_spi_init(hw_cfg.spi, CYBSP_SPI_MOSI, CYBSP_SPI_MISO, CYBSP_SPI_CLK, NC, NULL, 8,
+    if (cyhal_spi_init(&radar_spi, CYBSP_SPI_MOSI, CYBSP_SPI_MISO, CYBSP_SPI_CLK, NC, NULL, 8,
                        CYHAL_SPI_MODE_00_MSB, false) != CY_RSLT_SUCCESS )
     {
         CY_ASSERT(0);
     }
     /* Set the data rate to 25 Mbps */
-    if (cyhal_spi_set_frequency(hw_cfg.spi, SPI_FREQUENCY) != CY_RSLT_SUCCESS)
+    if (cyhal_spi_set_frequency(&radar_spi, SPI_FREQUENCY) != CY_RSLT_SUCCESS)
     {
         CY_ASSERT(0);
     }
 
-    /* Initialize RadarSensing context object for presence detection, */
-    /* also initialize radar device configuration */
-    if (mtb_radar_sensing_init(&sensing_context, &hw_cfg, MTB_RADAR_SENSING_MASK_PRESENCE_EVENTS) != MTB_RADAR_SENSING_SUCCESS)
-    {
-        printf("ifx_radar_sensing_init error - Radar Wingboard not connected?\n");
-        CY_ASSERT(0);
-    }
+#if (RADAR_SPI_DMA_ENABLE == 1)
+    /* Move the FIFO bursts of the driver to DMA */
+    radar_spi_dma_init(&radar_spi);
+#endif
+    radar_boot_mark(RADAR_BOOT_SPI);
 
-    /* Register callback to handle presence detection events */
-    if (mtb_radar_sensing_register_callback(&sensing_context, radar_sensing_callback, NULL) !=
-        MTB_RADAR_SENSING_SUCCESS)
+    for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
     {
-        CY_ASSERT(0);
+        radar_task_init_sensor(&sensors[i]);
     }
+    radar_boot_mark(RADAR_BOOT_SENSING);
 
-    /* Set parameter for presence detection */
-    if (mtb_radar_sensing_set_parameter(&sensing_context, "radar_presence_range_max", "1.0") !=
-        MTB_RADAR_SENSING_SUCCESS)
+    /* Set parameters for presence detection */
+    radar_task_restore();
+    radar_boot_mark(RADAR_BOOT_PARAMETERS);
+
+    /* Enable context objects */
+    for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
     {
-        CY_ASSERT(0);
+        if (mtb_radar_sensing_enable(&sensors[i].context) != MTB_RADAR_SENSING_SUCCESS)
+        {
+            CY_ASSERT(0);
+        }
     }
+    radar_boot_mark(RADAR_BOOT_ENABLE);
+    radar_adaptive_init(radar_time_ms());
 
-    if (mtb_radar_sensing_set_parameter(&sensing_context, "radar_presence_sensitivity", "medium") !=
-        MTB_RADAR_SENSING_SUCCESS)
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_IRQ)
+    TickType_t wait_ticks = RADAR_IRQ_TIMEOUT;
+    uint32_t first = 0U;
+
+    for (;;)
     {
-        CY_ASSERT(0);
+        /* Wait for a radar to signal that its FIFO has data */
+        (void)ulTaskNotifyTake(pdTRUE, wait_ticks);
+        uint32_t ready = radar_task_ready_sensors();
+        if (ready == 0U)
+        {
+            /* No frame pending: a safe point for parameter changes, too */
+            radar_task_run_commands();
+        }
+
+        /* Serve the ready sensors one frame each per pass, until all IRQ */
+        /* lines are released. The sensor served first changes with every */
+        /* pass.                                                          */
+        for (uint32_t pass = 0U; (ready != 0U) && (pass < RADAR_IRQ_MAX_BURST); pass++)
+        {
+            uint64_t ready_us = radar_time_us();
+            for (uint32_t n = 0U; n < RADAR_SENSOR_COUNT; n++)
+            {
+                uint32_t i = (first + n) % RADAR_SENSOR_COUNT;
+                if ((ready & (1UL << i)) != 0U)
+                {
+                    radar_task_process(&sensors[i], ready_us);
+                }
+            }
+            first = (first + 1U) % RADAR_SENSOR_COUNT;
+            ready = radar_task_ready_sensors();
+        }
+
+        /* Poll at tick rate if a FIFO could not be drained in one burst. */
+        /* Stopped radars raise no IRQ, so only the policy wakes the task. */
+        TickType_t adapt_ticks = radar_task_adapt();
+        wait_ticks = (ready != 0U) ? 1U : (radar_running ? RADAR_IRQ_TIMEOUT : portMAX_DELAY);
+        if (adapt_ticks < wait_ticks)
+        {
+            wait_ticks = adapt_ticks;
+        }
     }
+#elif (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_PERIODIC)
+    /* The first period starts now. The deadline of a period is the start of */
+    /* the next one, kept in us for the lateness.                            */
+    TickType_t last_wake = xTaskGetTickCount();
+    uint64_t deadline_us = radar_time_us() + RADAR_PERIOD_US;
 
-    /* Enable context object */
-    if (mtb_radar_sensing_enable(&sensing_context) != MTB_RADAR_SENSING_SUCCESS)
+    for (;;)
     {
-        CY_ASSERT(0);
-    }
+        TickType_t adapt_ticks = radar_task_adapt();
+        if (!radar_running)
+        {
+            /* Radars stopped: wait for the next phase or a parameter command */
+            (void)ulTaskNotifyTake(pdTRUE, adapt_ticks);
+            radar_task_run_commands();
+
+            /* The schedule starts again when the radars are started */
+            last_wake = xTaskGetTickCount();
+            deadline_us = radar_time_us() + RADAR_PERIOD_US;
+            continue;
+        }
 
+        uint64_t ready_us = radar_time_us();
+        for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
+        {
+            radar_task_process(&sensors[i], ready_us);
+        }
+        radar_task_end_period(&last_wake, &deadline_us);
+    }
+#else
     for (;;)
     {
-        /* Process data acquired from radar every 2ms */
-        if (mtb_radar_sensing_process(&sensing_context, ifx_currenttime()) != MTB_RADAR_SENSING_SUCCESS)
+        TickType_t adapt_ticks = radar_task_adapt();
+        if (!radar_running)
         {
-            printf("ifx_radar_sensing_process error\n");
-            CY_ASSERT(0);
+            /* Radars stopped: wait for the next phase or a parameter command */
+            (void)ulTaskNotifyTake(pdTRUE, adapt_ticks);
+            radar_task_run_commands();
+            continue;
+        }
+
+        /* Process data acquired from all radars every 2ms */
+        uint64_t ready_us = radar_time_us();
+        for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
+        {
+            radar_task_process(&sensors[i], ready_us);
         }
         vTaskDelay(MTB_RADAR_SENSING_PROCESS_DELAY);
     }
+#endif
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_set_parameters
+ ********************************************************************************
+ * Summary:
+ *   Writes a batch of RadarSensing parameters. The parameters are applied by
+ *   the radar task between two frames, with a single device reconfiguration
+ *   for the whole batch. Blocks until the batch has been applied. A batch
+ *   with a value out of the parameter table is rejected before it reaches
+ *   the radar task.
+ *
+ * Parameters:
+ *   params: parameters to write, must stay valid until the call returns
+ *   count: number of parameters
+ *
+ * Return:
+ *   MTB_RADAR_SENSING_SUCCESS if all parameters were written, otherwise the
+ *   first error
+ *******************************************************************************/
+mtb_radar_sensing_result_t radar_task_set_parameters(const radar_task_param_t *params, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!radar_params_is_valid(params[i].id, params[i].value))
+        {
+            return MTB_RADAR_SENSING_ERROR;
+        }
+    }
+
+    radar_task_param_cmd_t cmd =
+    {
+        .adaptive = NULL,
+        .params = params,
+        .count = count,
+        .result = MTB_RADAR_SENSING_ERROR
+    };
+
+    return radar_task_submit(&cmd);
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_get_values
+ ********************************************************************************
+ * Summary:
+ *   Copies the parameter values that all sensors currently run with. The
+ *   radar task keeps them when it applies parameters, so they are read
+ *   without waiting for it.
+ *
+ * Parameters:
+ *   values: RADAR_PARAMS entries for the values, indexed by radar_param_id_t
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_task_get_values(radar_param_value_t *values)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    memcpy(values, param_values, sizeof(param_values));
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_set_adaptive
+ ********************************************************************************
+ * Summary:
+ *   Changes the policy of the adaptive frame rate. The policy is changed by
+ *   the radar task between two frames. Blocks until it has been changed.
+ *
+ * Parameters:
+ *   config: new policy, see radar_adaptive_set_config
+ *
+ * Return:
+ *   MTB_RADAR_SENSING_SUCCESS, or MTB_RADAR_SENSING_ERROR if the policy is
+ *   out of the limits
+ *******************************************************************************/
+mtb_radar_sensing_result_t radar_task_set_adaptive(const radar_adaptive_config_t *config)
+{
+    radar_task_param_cmd_t cmd =
+    {
+        .adaptive = config,
+        .params = NULL,
+        .count = 0,
+        .result = MTB_RADAR_SENSING_ERROR
+    };
+
+    return radar_task_submit(&cmd);
 }
 
 /*******************************************************************************
@@ -299,10 +1265,138 @@ void radar_task(cy_thread_arg_t arg)
  *******************************************************************************/
 void radar_presence_task_set_mute(bool mute)
 {
-    if (mute)
+    radar_event_log_set_mute(mute);
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_get_cost
+ ********************************************************************************
+ * Summary:
+ *   Copies the processing cost of the enabled use cases since startup or the
+ *   last radar_task_reset_cost()
+ *
+ * Parameters:
+ *   cost: receives the processing cost
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_task_get_cost(radar_task_cost_t *cost)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    *cost = process_cost;
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_reset_cost
+ ********************************************************************************
+ * Summary:
+ *   Clears the processing cost of the enabled use cases
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_task_reset_cost(void)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    process_cost = (radar_task_cost_t){ 0 };
+    Cy_SysLib_ExitCriticalSection(status);
+}
+
+/*******************************************************************************
+ * Function Name: radar_task_print_modes
+ ********************************************************************************
+ * Summary:
+ *   Prints the enabled use cases, the time spent processing a frame with all
+ *   of them and the number of events of each. The library processes all use
+ *   cases in one call, so the cost of one use case is obtained by comparing
+ *   the mean with the one of a single-mode build, which is printed as a hint.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_task_print_modes(void)
+{
+    radar_task_cost_t cost;
+    radar_task_get_cost(&cost);
+
+    printf("Modes:%s%s\n",
+           ((RADAR_TASK_MODES & MTB_RADAR_SENSING_MASK_PRESENCE_EVENTS) != 0U) ? " presence" : "",
+           ((RADAR_TASK_MODES & MTB_RADAR_SENSING_MASK_COUNTER_EVENTS) != 0U) ? " counter" : "");
+    printf("Process: %" PRIu32 " frames, mean %" PRIu32 " us, max %" PRIu32 " us\n",
+           cost.frames,
+           (cost.frames != 0U) ? (uint32_t)(cost.total_us / cost.frames) : 0U,
+           cost.max_us);
+    printf("Events: %" PRIu32 " presence, %" PRIu32 " counter\n", cost.presence_events, cost.counter_events);
+
+    if (RADAR_TASK_MODES == RADAR_TASK_MODES_PRESENCE_COUNTER)
+    {
+        printf("Mode cost: mean minus the mean of a RADAR_MODES=COUNTER build is the presence detection,\n"
+               "  minus the mean of a RADAR_MODES=PRESENCE build is the entrance counter\n");
+    }
+    else
+    {
+        printf("Mode cost: single-mode build, the mean is the cost of the %s\n",
+               (RADAR_TASK_MODES == RADAR_TASK_MODES_PRESENCE) ? "presence detection" : "entrance counter");
+    }
+}
+
+#if (RADAR_SENSOR_COUNT > 1)
+/*******************************************************************************
+ * Function Name: radar_task_print_sensors
+ ********************************************************************************
+ * Summary:
+ *   Prints the number of frames processed per sensor and the longest time a
+ *   sensor with data has waited for the shared SPI bus.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_task_print_sensors(void)
+{
+    printf("sensor     frames  max bus wait\n");
+    for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
     {
-        radar_presence_terminal_mutex_get(CY_RTOS_NEVER_TIMEOUT);
-        return;
+        printf("%6u %10" PRIu32 " %10" PRIu32 " us\n",
+               (unsigned int)i,
+               sensors[i].frames,
+               sensors[i].max_wait_us);
     }
-    radar_presence_terminal_mutex_release();
 }
+#endif
+
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_PERIODIC)
+/*******************************************************************************
+ * Function Name: radar_task_print_period
+ ********************************************************************************
+ * Summary:
+ *   Prints the deadline statistics of the periodic processing: periods,
+ *   overruns, skipped period starts and the worst lateness.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_task_print_period(void)
+{
+    printf("Period %u ms: %" PRIu32 " periods, %" PRIu32 " overruns, %" PRIu32 " skipped, worst late %" PRIu32
+           " us\n",
+           (unsigned int)(RADAR_PERIOD_US / 1000U),
+           period_stats.periods,
+           period_stats.overruns,
+           period_stats.missed,
+           period_stats.max_late_us);
+}
+#endif
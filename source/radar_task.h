@@ -34,6 +34,10 @@
 /* Header file for library */
 #include "mtb_radar_sensing.h"
 
+/* Header file for local module */
+#include "radar_adaptive.h"
+#include "radar_params.h"
+
 /*******************************************************************************
  * Macros
  ******************************************************************************/
@@ -41,16 +45,85 @@
 #define RADAR_TASK_NAME "RADAR PRESENCE TASK"
 /* Stack size for the radar task */
 #define RADAR_TASK_STACK_SIZE (4096)
-/* Priority number for the radar task */
+/* Priority number for the radar task, must be above the terminal UI, event
+   log and capture tasks */
+#ifndef RADAR_TASK_PRIORITY
 #define RADAR_TASK_PRIORITY (CY_RTOS_PRIORITY_NORMAL)
+#endif
+
+/* Process data every MTB_RADAR_SENSING_PROCESS_DELAY ticks */
+#define RADAR_TASK_PROCESS_MODE_POLL (0)
+/* Process data when the radar IRQ line signals that the FIFO has data */
+#define RADAR_TASK_PROCESS_MODE_IRQ (1)
+/* Process data at a fixed period of MTB_RADAR_SENSING_PROCESS_DELAY ticks,
+   with deadline and overrun tracking */
+#define RADAR_TASK_PROCESS_MODE_PERIODIC (2)
+
+/* Frame processing mode, selected with RADAR_PROCESS_MODE in the Makefile */
+#ifndef RADAR_TASK_PROCESS_MODE
+#define RADAR_TASK_PROCESS_MODE (RADAR_TASK_PROCESS_MODE_IRQ)
+#endif
+
+/* Presence detection */
+#define RADAR_TASK_MODES_PRESENCE (MTB_RADAR_SENSING_MASK_PRESENCE_EVENTS)
+/* Entrance counter */
+#define RADAR_TASK_MODES_COUNTER (MTB_RADAR_SENSING_MASK_COUNTER_EVENTS)
+/* Presence detection and entrance counter on the same frames */
+#define RADAR_TASK_MODES_PRESENCE_COUNTER (MTB_RADAR_SENSING_MASK_PRESENCE_EVENTS | \
+                                           MTB_RADAR_SENSING_MASK_COUNTER_EVENTS)
+
+/* RadarSensing use cases, selected with RADAR_MODES in the Makefile */
+#ifndef RADAR_TASK_MODES
+#define RADAR_TASK_MODES (RADAR_TASK_MODES_PRESENCE)
+#endif
+
+/* Number of radar wingboards sharing the SPI bus, selected with RADAR_SENSORS
+   in the Makefile */
+#ifndef RADAR_SENSOR_COUNT
+#define RADAR_SENSOR_COUNT (1U)
+#endif
+
+#if (RADAR_SENSOR_COUNT < 1) || (RADAR_SENSOR_COUNT > 3)
+#error "RADAR_SENSOR_COUNT must be 1, 2 or 3"
+#endif
+
+/* Number of parameter commands that can wait for the radar task */
+#define RADAR_TASK_PARAM_QUEUE_LENGTH (4U)
 
 /*******************************************************************************
- * Global Variables
+ * Types
  *******************************************************************************/
-extern mtb_radar_sensing_context_t sensing_context;
+typedef struct
+{
+    radar_param_id_t id;       /* Entry of the parameter table */
+    radar_param_value_t value; /* Value of the type of the entry */
+} radar_task_param_t;
+
+/* Processing cost of the enabled use cases, written by the radar task */
+typedef struct
+{
+    uint32_t frames;          /* Frames processed by all sensors */
+    uint64_t total_us;        /* Time spent in mtb_radar_sensing_process(), callbacks included */
+    uint32_t max_us;          /* Longest process call */
+    uint32_t presence_events; /* Events of the presence detection */
+    uint32_t counter_events;  /* Events of the entrance counter */
+} radar_task_cost_t;
 
 /*******************************************************************************
  * Functions
  *******************************************************************************/
+void radar_task_init(void);
 void radar_task(cy_thread_arg_t arg);
 void radar_presence_task_set_mute(bool mute);
+mtb_radar_sensing_result_t radar_task_set_parameters(const radar_task_param_t *params, uint32_t count);
+void radar_task_get_values(radar_param_value_t *values);
+mtb_radar_sensing_result_t radar_task_set_adaptive(const radar_adaptive_config_t *config);
+void radar_task_get_cost(radar_task_cost_t *cost);
+void radar_task_reset_cost(void);
+void radar_task_print_modes(void);
+#if (RADAR_SENSOR_COUNT > 1)
+void radar_task_print_sensors(void);
+#endif
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_PERIODIC)
+void radar_task_print_period(void);
+#endif
@@ -0,0 +1,191 @@
+/*****************************************************************************
+** File name: radar_telemetry.c
+**
+** Description: This file implements the telemetry of the radar presence
+** application. The radar task adds a sample per frame and sensor, and every
+** interval the samples are reduced to one record with the occupancy and the
+** last reported distance, which is published on the event bus, so the output
+** rate does not depend on the frame rate.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/* Header file includes */
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_event_bus.h"
+#include "radar_task.h"
+#include "radar_telemetry.h"
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Samples of the current interval of one sensor */
+typedef struct
+{
+    uint64_t start_us;   /* Start of the interval */
+    uint32_t frames;     /* Frames in the interval */
+    uint32_t present;    /* Frames with presence */
+    float distance;      /* Distance of the last PRESENCE_IN event, 0 if no presence */
+    float accuracy;      /* Accuracy of the last PRESENCE_IN event, 0 if no presence */
+} radar_telemetry_window_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+/* Written by the terminal UI task, read by the radar task */
+static volatile uint32_t telemetry_interval_ms;
+
+/* Radar task only */
+static radar_telemetry_window_t telemetry_windows[RADAR_SENSOR_COUNT];
+static uint32_t telemetry_window_ms;
+
+/*******************************************************************************
+ * Function Name: radar_telemetry_set_interval
+ ********************************************************************************
+ * Summary:
+ *   Sets the telemetry interval. The radar task starts new intervals with
+ *   its next sample.
+ *
+ * Parameters:
+ *   interval_ms: interval, 0 for off
+ *
+ * Return:
+ *   true if the interval is 0 or within the limits
+ *******************************************************************************/
+bool radar_telemetry_set_interval(uint32_t interval_ms)
+{
+    if ((interval_ms != 0U) &&
+        ((interval_ms < RADAR_TELEMETRY_MIN_INTERVAL_MS) || (interval_ms > RADAR_TELEMETRY_MAX_INTERVAL_MS)))
+    {
+        return false;
+    }
+
+    telemetry_interval_ms = interval_ms;
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: radar_telemetry_get_interval
+ ********************************************************************************
+ * Summary:
+ *   Returns the telemetry interval
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   interval in ms, 0 if the telemetry is off
+ *******************************************************************************/
+uint32_t radar_telemetry_get_interval(void)
+{
+    return telemetry_interval_ms;
+}
+
+/*******************************************************************************
+ * Function Name: radar_telemetry_publish
+ ********************************************************************************
+ * Summary:
+ *   Turns the samples of an interval into a RADAR_EVENT_TELEMETRY record
+ *   and publishes it on the event bus.
+ *
+ * Parameters:
+ *   sensor: index of the sensor
+ *   window: samples of the interval
+ *   time_us: end of the interval
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void radar_telemetry_publish(uint32_t sensor, const radar_telemetry_window_t *window, uint64_t time_us)
+{
+    radar_event_record_t record =
+    {
+        .timestamp_us = time_us,
+        .distance = window->distance,
+        .accuracy = window->accuracy,
+        .event = RADAR_EVENT_TELEMETRY,
+        .sensor = (uint8_t)sensor,
+        .occupancy = (uint8_t)((window->present * 100U + (window->frames / 2U)) / window->frames)
+    };
+
+#if (RADAR_LATENCY_ENABLE == 1)
+    record.trace = RADAR_LATENCY_NO_TRACE;
+#endif
+    radar_event_bus_publish(&record);
+}
+
+/*******************************************************************************
+ * Function Name: radar_telemetry_sample
+ ********************************************************************************
+ * Summary:
+ *   Adds the state of a sensor after a frame to the current interval, and
+ *   publishes the interval once it has passed. Called by the radar task
+ *   after every frame.
+ *
+ * Parameters:
+ *   sensor: index of the sensor
+ *   present: true if the sensor reports presence
+ *   distance: distance of the last PRESENCE_IN event in m, valid if present
+ *   accuracy: accuracy of the last PRESENCE_IN event in m, valid if present
+ *   time_us: time of the frame
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_telemetry_sample(uint32_t sensor, bool present, float distance, float accuracy, uint64_t time_us)
+{
+    uint32_t interval_ms = telemetry_interval_ms;
+    radar_telemetry_window_t *window = &telemetry_windows[sensor];
+
+    if (interval_ms != telemetry_window_ms)
+    {
+        /* New interval: restart the windows of all sensors */
+        for (uint32_t i = 0; i < RADAR_SENSOR_COUNT; i++)
+        {
+            telemetry_windows[i] = (radar_telemetry_window_t){ .start_us = time_us };
+        }
+        telemetry_window_ms = interval_ms;
+    }
+
+    if (interval_ms == 0U)
+    {
+        return;
+    }
+
+    window->frames++;
+    if (present)
+    {
+        window->present++;
+        window->distance = distance;
+        window->accuracy = accuracy;
+    }
+
+    uint64_t interval_us = (uint64_t)interval_ms * 1000U;
+    if ((time_us - window->start_us) >= interval_us)
+    {
+        radar_telemetry_publish(sensor, window, time_us);
+
+        /* Keep the grid of the intervals, unless the radars have been
+           stopped for longer than an interval */
+        uint64_t start_us = window->start_us + interval_us;
+        *window = (radar_telemetry_window_t){ .start_us = ((time_us - start_us) < interval_us) ? start_us : time_us };
+    }
+}
@@ -0,0 +1,45 @@
+/******************************************************************************
+** File name: radar_telemetry.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_telemetry.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Limits of the telemetry interval, 0 turns the telemetry off. The interval
+   fixes the output rate of every sensor, whatever the frame rate. */
+#define RADAR_TELEMETRY_MIN_INTERVAL_MS (100U)
+#define RADAR_TELEMETRY_MAX_INTERVAL_MS (60000U)
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+bool radar_telemetry_set_interval(uint32_t interval_ms);
+uint32_t radar_telemetry_get_interval(void);
+void radar_telemetry_sample(uint32_t sensor, bool present, float distance, float accuracy, uint64_t time_us);
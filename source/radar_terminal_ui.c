@@ -25,6 +25,7 @@
 
 /* Header file from system */
 #include <ctype.h>
+#include <inttypes.h>
 #include <stdlib.h>
 
 /* Header file includes */
@@ -33,12 +34,35 @@
 #include "cyhal.h"
 
 /* Header file for local task */
+#include "radar_adaptive.h"
+#include "radar_boot.h"
+#include "radar_capture.h"
+#include "radar_coalesce.h"
+#include "radar_console.h"
+#include "radar_event_bus.h"
+#include "radar_event_log.h"
+#include "radar_latency.h"
+#include "radar_load.h"
+#include "radar_params.h"
+#include "radar_low_power.h"
+#include "radar_profile.h"
+#include "radar_profiler.h"
+#include "radar_rtos.h"
+#include "radar_spi_dma.h"
+#include "radar_stats.h"
+#include "radar_sweep.h"
+#include "radar_telemetry.h"
 #include "radar_terminal_ui.h"
 
 /*******************************************************************************
  * Constants
  *******************************************************************************/
-#define IFX_RADAR_SENSING_VALUE_MAXLENGTH 256
+/* Longest input line, terminating zero included */
+#define IFX_RADAR_SENSING_VALUE_MAXLENGTH 32
+/* Printed in front of the input line */
+#define TERMINAL_UI_PROMPT "> "
+/* Period in ms at which the UART is polled for a key without the RX ring */
+#define TERMINAL_UI_POLL_MS (10U)
 
 /*******************************************************************************
  * Function Name: terminal_ui_menu
@@ -46,7 +70,9 @@
  * Summary:
  *   This function prints the available parameters configurable for presence
  *   detection application. The existing values of the parameters are also
- *   displayed with their units (if any).
+ *   displayed with their units (if any), as kept by the radar task. All
+ *   values are collected before the console is muted, so the events are only
+ *   held while the menu is printed.
  *
  * Parameters:
  *   none
@@ -56,21 +82,73 @@
  *******************************************************************************/
 static void terminal_ui_menu(void)
 {
-    char value[IFX_RADAR_SENSING_VALUE_MAXLENGTH];
+    radar_param_value_t values[RADAR_PARAMS];
+    char range[RADAR_PARAMS_VALUE_MAXLENGTH];
+    char sensitivity[RADAR_PARAMS_VALUE_MAXLENGTH];
+    radar_adaptive_config_t adaptive;
+
+    radar_task_get_values(values);
+    radar_params_format(RADAR_PARAM_RANGE_MAX, values[RADAR_PARAM_RANGE_MAX], range, sizeof(range));
+    radar_params_format(RADAR_PARAM_SENSITIVITY, values[RADAR_PARAM_SENSITIVITY], sensitivity, sizeof(sensitivity));
+    radar_adaptive_get_config(&adaptive);
+    uint32_t telemetry_ms = radar_telemetry_get_interval();
+    uint32_t hold_ms = radar_coalesce_get_hold();
+    bool saved = (radar_profile_load() != NULL);
+
     radar_presence_task_set_mute(true);
 
     /* Print main menu */
     printf("Select a setting to configure\n");
-    mtb_radar_sensing_get_parameter(&sensing_context,
-                                  "radar_presence_range_max",
-                                  value,
-                                  IFX_RADAR_SENSING_VALUE_MAXLENGTH);
-    printf("'r': Set presence max range (%s)\n", value);
-    mtb_radar_sensing_get_parameter(&sensing_context,
-                                  "radar_presence_sensitivity",
-                                  value,
-                                  IFX_RADAR_SENSING_VALUE_MAXLENGTH);
-    printf("'s': Set sensitivity (%s)\n", value);
+    printf("'r': Set presence max range (%s)\n", range);
+    printf("'s': Set sensitivity (%s)\n", sensitivity);
+    if (adaptive.idle_s == 0U)
+    {
+        printf("'a': Set adaptive frame rate (off)\n");
+    }
+    else
+    {
+        printf("'a': Set adaptive frame rate (after %" PRIu32 " s, %" PRIu32 " of %" PRIu32 " ms)\n",
+               adaptive.idle_s,
+               adaptive.on_ms,
+               adaptive.period_ms);
+    }
+    if (telemetry_ms == 0U)
+    {
+        printf("'d': Set telemetry interval (off)\n");
+    }
+    else
+    {
+        printf("'d': Set telemetry interval (%" PRIu32 " ms)\n", telemetry_ms);
+    }
+    if (hold_ms == 0U)
+    {
+        printf("'h': Set presence hold time (off)\n");
+    }
+    else
+    {
+        printf("'h': Set presence hold time (%" PRIu32 " ms)\n", hold_ms);
+    }
+    printf("'w': Save settings to flash, 'W': erase them (%s)\n", saved ? "saved" : "not saved");
+    printf("'e': Show event bus statistics\n");
+    printf("'t': Show task statistics\n");
+    printf("'b': Toggle binary event output (%s)\n", radar_event_log_is_binary() ? "on" : "off");
+    printf("'i': Show boot phases\n");
+    printf("'m': Show sensing modes and processing cost\n");
+    printf("'x': Run the parameter sweep benchmark\n");
+#if (RADAR_LOW_POWER_ENABLE == 1)
+    printf("'p': Show sleep/active time%s\n", (RADAR_LOAD_ENABLE == 1) ? " and CPU load" : "");
+#elif (RADAR_LOAD_ENABLE == 1)
+    printf("'p': Show CPU load\n");
+#endif
+#if (RADAR_PROFILER_ENABLE == 1)
+    printf("'c': Show processing cycle profile, 'C': reset it\n");
+#endif
+#if (RADAR_LATENCY_ENABLE == 1)
+    printf("'l': Show IRQ-to-output latency, 'L': reset it\n");
+#endif
+#if (RADAR_CAPTURE_ENABLE == 1)
+    printf("'f': Start/stop raw frame capture (%s)\n", radar_capture_is_active() ? "on" : "off");
+#endif
     printf("\n");
 
     radar_presence_task_set_mute(false);
@@ -94,46 +172,125 @@ static void terminal_ui_info(void)
     printf("Press '?' to list all radar presence settings\n");
 }
 
+/*******************************************************************************
+ * Function Name: terminal_ui_getc
+ ********************************************************************************
+ * Summary:
+ *   Waits for a key without using the CPU. With the RX ring, cyhal_uart_getc()
+ *   sleeps until the UART interrupt wakes up the task. Without it, the HAL
+ *   would spin on the UART FIFO and starve the lower priority event log and
+ *   capture tasks and the idle task, so the task sleeps between two polls.
+ *
+ * Parameters:
+ *   uart_ptr: UART object
+ *   value: received character
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS if a character was received
+ *******************************************************************************/
+static cy_rslt_t terminal_ui_getc(void *uart_ptr, uint8_t *value)
+{
+#if (RADAR_CONSOLE_RX_RING_ENABLE == 0)
+    while (cyhal_uart_readable(uart_ptr) == 0U)
+    {
+        vTaskDelay(pdMS_TO_TICKS(TERMINAL_UI_POLL_MS));
+    }
+#endif
+    return cyhal_uart_getc(uart_ptr, value, 0);
+}
+
 /*******************************************************************************
  * Function Name: terminal_ui_readline
  ********************************************************************************
  * Summary:
- *   This function reads values entered by a user and prints it.
+ *   This function prints a prompt and reads a line entered by a user, with
+ *   backspace to correct it and ESC to cancel it. The console is only muted
+ *   while a character is handled, not while the user types, and the event
+ *   log draws the prompt and the line again below every event printed in the
+ *   meantime. An empty line cancels the input like ESC.
  *
  * Parameters:
  *   uart_ptr: UART object
- *   line: value to be read
+ *   line: value to be read, empty if the input was cancelled
  *   maxlength: maximum number of characters to be read
  *
  * Return:
- *   none
+ *   true if a line was entered, false if the input was cancelled
  *******************************************************************************/
-static void terminal_ui_readline(void *uart_ptr, char *line, int maxlength)
+static bool terminal_ui_readline(void *uart_ptr, char *line, int maxlength)
 {
-    radar_presence_task_set_mute(true);
-
     if (maxlength <= 0)
     {
-        return;
+        return false;
     }
 
     int i = 0;
     uint8_t rx_value = 0;
-    /* Receive character until enter has been pressed */
-    while ((rx_value != '\r') && (--maxlength > 0))
+    bool done = false;
+
+    line[0] = '\0';
+    radar_presence_task_set_mute(true);
+    printf("%s", TERMINAL_UI_PROMPT);
+    (void)fflush(stdout);
+    radar_event_log_set_input(TERMINAL_UI_PROMPT, line);
+    radar_presence_task_set_mute(false);
+
+    /* Receive characters until enter has been pressed */
+    while (!done)
     {
-        cyhal_uart_getc(uart_ptr, &rx_value, 0);
-        cyhal_uart_putc(uart_ptr, rx_value);
-        if (isspace(rx_value))
+        /* Waits without holding the console */
+        if (terminal_ui_getc(uart_ptr, &rx_value) != CY_RSLT_SUCCESS)
         {
             continue;
         }
-        line[i++] = rx_value;
+
+        radar_presence_task_set_mute(true);
+        /* Keep the echo behind text that is still buffered */
+        (void)fflush(stdout);
+        switch (rx_value)
+        {
+            case '\r':
+            case '\n':
+                done = true;
+                break;
+            case '\x1b':
+                i = 0;
+                done = true;
+                break;
+            case '\b':
+            case '\x7f':
+                if (i > 0)
+                {
+                    line[--i] = '\0';
+                    cyhal_uart_putc(uart_ptr, '\b');
+                    cyhal_uart_putc(uart_ptr, ' ');
+                    cyhal_uart_putc(uart_ptr, '\b');
+                }
+                break;
+            default:
+                if (!isspace(rx_value) && isprint(rx_value) && (i < (maxlength - 1)))
+                {
+                    line[i++] = (char)rx_value;
+                    line[i] = '\0';
+                    cyhal_uart_putc(uart_ptr, rx_value);
+                }
+                break;
+        }
+        if (done)
+        {
+            line[i] = '\0';
+            radar_event_log_set_input(NULL, NULL);
+            cyhal_uart_putc(uart_ptr, '\r');
+            cyhal_uart_putc(uart_ptr, '\n');
+            if (i == 0)
+            {
+                printf("Cancelled\n");
+            }
+        }
+        radar_presence_task_set_mute(false);
     }
-    cyhal_uart_putc(uart_ptr, '\n');
-    line[i] = '\0';
 
-    radar_presence_task_set_mute(false);
+    return (i > 0);
 }
 
 /*******************************************************************************
@@ -161,10 +318,435 @@ static void terminal_ui_print_result(cy_rslt_t result)
     }
 }
 
+/*******************************************************************************
+ * Function Name: terminal_ui_set_parameter
+ ********************************************************************************
+ * Summary:
+ *   This function checks an entered value against the parameter table, hands
+ *   it over to the radar task, which applies it between two frames, and
+ *   displays the result. Invalid input does not reach the radar task.
+ *
+ * Parameters:
+ *   id: parameter
+ *   text: entered value
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_set_parameter(radar_param_id_t id, const char *text)
+{
+    radar_task_param_t param = { .id = id };
+
+    if (!radar_params_parse(id, text, &param.value))
+    {
+        terminal_ui_print_result(MTB_RADAR_SENSING_ERROR);
+        return;
+    }
+    terminal_ui_print_result(radar_task_set_parameters(&param, 1));
+}
+
+/*******************************************************************************
+ * Function Name: terminal_ui_print_event_stats
+ ********************************************************************************
+ * Summary:
+ *   This function displays for every subscriber of the event bus the number
+ *   of events received and lost because the subscriber lagged behind, and
+ *   the highest number of events that waited for it.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_print_event_stats(void)
+{
+    const radar_event_bus_subscriber_t *subscriber;
+    radar_event_bus_stats_t stats;
+
+    radar_presence_task_set_mute(true);
+    for (uint32_t i = 0; (subscriber = radar_event_bus_get_subscriber(i)) != NULL; i++)
+    {
+        radar_event_bus_get_stats(subscriber, &stats);
+        printf("%s: %" PRIu32 " received, dropped %" PRIu32 " IN, %" PRIu32 " OUT, high-water mark %" PRIu32
+               "/%" PRIu32 "\n",
+               subscriber->name,
+               stats.received,
+               stats.dropped[RADAR_EVENT_PRESENCE_IN],
+               stats.dropped[RADAR_EVENT_PRESENCE_OUT],
+               stats.max_lag,
+               subscriber->depth);
+    }
+    radar_presence_task_set_mute(false);
+}
+
+/*******************************************************************************
+ * Function Name: terminal_ui_print_adaptive
+ ********************************************************************************
+ * Summary:
+ *   This function displays the state of the adaptive frame rate, how often
+ *   it has switched to the low rate and the time spent at the low rate and
+ *   with the radars stopped.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_print_adaptive(void)
+{
+    static const char *const state_names[] =
+    {
+        [RADAR_ADAPTIVE_FULL] = "full rate",
+        [RADAR_ADAPTIVE_LOW_ON] = "low rate, radar running",
+        [RADAR_ADAPTIVE_LOW_OFF] = "low rate, radar stopped"
+    };
+    radar_adaptive_stats_t stats;
+    radar_adaptive_get_stats(&stats);
+
+    radar_presence_task_set_mute(true);
+    printf("Adaptive frame rate: %s, %" PRIu32 " times low rate for %" PRIu32 " s, radar stopped %" PRIu32 " s\n",
+           state_names[stats.state],
+           stats.low_count,
+           (uint32_t)(stats.low_ms / 1000U),
+           (uint32_t)(stats.off_ms / 1000U));
+    radar_presence_task_set_mute(false);
+}
+
+/*******************************************************************************
+ * Function Name: terminal_ui_set_adaptive
+ ********************************************************************************
+ * Summary:
+ *   This function parses a policy of the adaptive frame rate, either "0" to
+ *   turn it off or "idle,period,on" in s and ms, hands it over to the radar
+ *   task and displays the result.
+ *
+ * Parameters:
+ *   line: policy entered by the user
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_set_adaptive(const char *line)
+{
+    unsigned long values[3];
+    uint32_t count = 0;
+    const char *next = line;
+    char *end;
+
+    do
+    {
+        values[count++] = strtoul(next, &end, 10);
+        if (end == next)
+        {
+            terminal_ui_print_result(MTB_RADAR_SENSING_ERROR);
+            return;
+        }
+        next = end + 1;
+    } while ((*end == ',') && (count < 3U));
+
+    if ((*end != '\0') || !(((count == 1U) && (values[0] == 0U)) || (count == 3U)))
+    {
+        terminal_ui_print_result(MTB_RADAR_SENSING_ERROR);
+        return;
+    }
+
+    radar_adaptive_config_t config;
+    radar_adaptive_get_config(&config);
+    config.idle_s = (uint32_t)values[0];
+    if (count == 3U)
+    {
+        config.period_ms = (uint32_t)values[1];
+        config.on_ms = (uint32_t)values[2];
+    }
+    terminal_ui_print_result(radar_task_set_adaptive(&config));
+}
+
+/*******************************************************************************
+ * Function Name: terminal_ui_set_telemetry
+ ********************************************************************************
+ * Summary:
+ *   This function parses a telemetry interval in ms, "0" turns the telemetry
+ *   off, hands it over to the telemetry and displays the result.
+ *
+ * Parameters:
+ *   line: interval entered by the user
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_set_telemetry(const char *line)
+{
+    char *end;
+    unsigned long interval_ms = strtoul(line, &end, 10);
+
+    if ((end == line) || (*end != '\0') || !radar_telemetry_set_interval((uint32_t)interval_ms))
+    {
+        terminal_ui_print_result(MTB_RADAR_SENSING_ERROR);
+        return;
+    }
+    terminal_ui_print_result(MTB_RADAR_SENSING_SUCCESS);
+}
+
+/*******************************************************************************
+ * Function Name: terminal_ui_print_hold
+ ********************************************************************************
+ * Summary:
+ *   This function displays the presence events reported by the library and
+ *   the ones that the coalescing has not published.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_print_hold(void)
+{
+    radar_coalesce_stats_t stats;
+    radar_coalesce_get_stats(&stats);
+
+    printf("Presence events: %" PRIu32 ", coalesced: %" PRIu32 "\n", stats.raw, stats.coalesced);
+}
+
+/*******************************************************************************
+ * Function Name: terminal_ui_set_hold
+ ********************************************************************************
+ * Summary:
+ *   This function parses a hold time of the presence out events in ms, "0"
+ *   turns the coalescing off, hands it over to the coalescing and displays
+ *   the result.
+ *
+ * Parameters:
+ *   line: hold time entered by the user
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_set_hold(const char *line)
+{
+    char *end;
+    unsigned long hold_ms = strtoul(line, &end, 10);
+
+    if ((end == line) || (*end != '\0') || !radar_coalesce_set_hold((uint32_t)hold_ms))
+    {
+        terminal_ui_print_result(MTB_RADAR_SENSING_ERROR);
+        return;
+    }
+    terminal_ui_print_result(MTB_RADAR_SENSING_SUCCESS);
+}
+
+/*******************************************************************************
+ * Function Name: terminal_ui_sweep
+ ********************************************************************************
+ * Summary:
+ *   This function parses the number of frames per setting and runs the
+ *   parameter sweep.
+ *
+ * Parameters:
+ *   line: number of frames entered by the user
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_sweep(const char *line)
+{
+    char *end;
+    unsigned long frames = strtoul(line, &end, 10);
+
+    if ((end == line) || (*end != '\0') || (frames < RADAR_SWEEP_MIN_FRAMES) || (frames > RADAR_SWEEP_MAX_FRAMES))
+    {
+        terminal_ui_print_result(MTB_RADAR_SENSING_ERROR);
+        return;
+    }
+
+    radar_sweep_run((uint32_t)frames);
+}
+
+#if (RADAR_LOW_POWER_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: terminal_ui_print_power
+ ********************************************************************************
+ * Summary:
+ *   This function displays the time the CPU spent in deep sleep, CPU sleep and
+ *   active mode since startup.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_print_power(void)
+{
+    radar_low_power_stats_t stats;
+    radar_low_power_get_stats(&stats);
+
+    uint64_t asleep_ms = stats.deep_sleep_ms + stats.sleep_ms;
+    uint64_t active_ms = (stats.uptime_ms > asleep_ms) ? (stats.uptime_ms - asleep_ms) : 0U;
+    float scale = (stats.uptime_ms > 0U) ? (100.0f / (float)stats.uptime_ms) : 0.0f;
+
+    radar_presence_task_set_mute(true);
+    printf("Uptime:     %" PRIu64 " ms\n", stats.uptime_ms);
+    printf("Deep sleep: %" PRIu64 " ms (%.1f%%, %" PRIu32 " entries)\n",
+           stats.deep_sleep_ms,
+           (float)stats.deep_sleep_ms * scale,
+           stats.deep_sleep_count);
+    printf("CPU sleep:  %" PRIu64 " ms (%.1f%%, %" PRIu32 " entries)\n",
+           stats.sleep_ms,
+           (float)stats.sleep_ms * scale,
+           stats.sleep_count);
+    printf("Active:     %" PRIu64 " ms (%.1f%%)\n", active_ms, (float)active_ms * scale);
+    printf("Deep sleep refused: %" PRIu32 "\n", stats.refused_count);
+    radar_presence_task_set_mute(false);
+}
+#endif
+
+#if (RADAR_LOAD_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: terminal_ui_print_load
+ ********************************************************************************
+ * Summary:
+ *   This function displays the CPU load, the sleep residency and the active
+ *   time per frame of the last window of the load meter.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_print_load(void)
+{
+    radar_load_stats_t stats;
+    radar_load_get_stats(&stats);
+
+    radar_presence_task_set_mute(true);
+    if (stats.window_ms == 0U)
+    {
+        printf("CPU load: no complete window yet\n");
+    }
+    else
+    {
+        printf("CPU load:   %u.%u%% of %" PRIu32 " ms, %" PRIu32 " frames\n",
+               (unsigned int)(stats.load_permille / 10U),
+               (unsigned int)(stats.load_permille % 10U),
+               stats.window_ms,
+               stats.frames);
+#if (RADAR_LOW_POWER_ENABLE == 1)
+        printf("Asleep:     %u.%u%%\n",
+               (unsigned int)(stats.sleep_permille / 10U),
+               (unsigned int)(stats.sleep_permille % 10U));
+#endif
+        printf("Active per frame: %" PRIu32 " us\n", stats.frame_active_us);
+    }
+    radar_presence_task_set_mute(false);
+}
+#endif
+
+#if (RADAR_SPI_DMA_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: terminal_ui_print_spi_dma
+ ********************************************************************************
+ * Summary:
+ *   This function displays how many radar SPI transfers were done by DMA and
+ *   by the CPU. Must be called with the console muted.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_print_spi_dma(void)
+{
+    radar_spi_dma_stats_t stats;
+    radar_spi_dma_get_stats(&stats);
+
+    printf("SPI DMA: %" PRIu32 " transfers, %" PRIu64 " B, %" PRIu32 " timeouts\n",
+           stats.dma_transfers,
+           stats.dma_bytes,
+           stats.timeouts);
+    printf("SPI CPU: %" PRIu32 " transfers below %u B\n", stats.cpu_transfers, (unsigned int)RADAR_SPI_DMA_THRESHOLD);
+}
+#endif
+
+#if (RADAR_CAPTURE_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: terminal_ui_toggle_capture
+ ********************************************************************************
+ * Summary:
+ *   This function starts or stops the raw frame capture. When the capture is
+ *   stopped, the number of streamed, dropped and truncated frames is
+ *   displayed.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_toggle_capture(void)
+{
+    radar_capture_stats_t stats;
+
+    if (!radar_capture_is_active())
+    {
+        printf("Frame capture on\n");
+        radar_capture_set_active(true);
+        return;
+    }
+
+    radar_capture_set_active(false);
+    radar_capture_get_stats(&stats);
+    radar_presence_task_set_mute(true);
+    printf("Frame capture off: %" PRIu32 " frames, %" PRIu32 " dropped, %" PRIu32 " truncated\n",
+           stats.frames,
+           stats.dropped,
+           stats.truncated);
+    radar_presence_task_set_mute(false);
+}
+#endif
+
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1) || (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+/*******************************************************************************
+ * Function Name: terminal_ui_print_console
+ ********************************************************************************
+ * Summary:
+ *   This function displays the high-water mark of the console transmit ring,
+ *   how often a write had to wait for space and how many received characters
+ *   were lost. Must be called with the console muted.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void terminal_ui_print_console(void)
+{
+    radar_console_stats_t stats;
+    radar_console_get_stats(&stats);
+
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1)
+    printf("Console TX ring high-water mark: %" PRIu32 "/%u B, full %" PRIu32 " times\n",
+           stats.tx_max_level,
+           (unsigned int)RADAR_CONSOLE_TX_RING_SIZE,
+           stats.tx_full);
+#endif
+#if (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+    printf("Console RX characters lost: %" PRIu32 "\n", stats.rx_lost);
+#endif
+}
+#endif
+
 /*******************************************************************************
  * Function Name: radar_presence_terminal_ui
  ********************************************************************************
  * Summary:
+ *   Prints the banner while the radar task brings up the sensors, then the
+ *   menu and the boot phases once the first frame has been processed.
  *   Continuously checks if a key has been pressed to configure presence
  *   detection parameters. Displays a status message according to the user
  *   input/selection.
@@ -177,12 +759,29 @@ static void terminal_ui_print_result(cy_rslt_t result)
  *******************************************************************************/
 void radar_presence_terminal_ui(cy_thread_arg_t arg)
 {
+    /* \x1b[2J\x1b[;H - ANSI ESC sequence to clear screen. */
+    printf("\x1b[2J\x1b[;H");
+    printf("============================================================\n");
+    printf("Connected Sensor Kit: Radar Presence Application on FreeRTOS\n");
+    printf("============================================================\n\n");
+
+    /* The menu shows the parameters the radars run with, so it waits for */
+    /* the radar task to apply them                                       */
+    bool booted = radar_boot_wait(RADAR_BOOT_REPORT_TIMEOUT);
     terminal_ui_menu();
+    radar_boot_mark(RADAR_BOOT_MENU);
+    if (booted)
+    {
+        radar_presence_task_set_mute(true);
+        radar_boot_print();
+        radar_presence_task_set_mute(false);
+    }
+
     char value[IFX_RADAR_SENSING_VALUE_MAXLENGTH];
     uint8_t rx_value;
 
     /* Check if a key was pressed */
-    while (cyhal_uart_getc(&cy_retarget_io_uart_obj, &rx_value, 0) == CY_RSLT_SUCCESS)
+    while (terminal_ui_getc(&cy_retarget_io_uart_obj, &rx_value) == CY_RSLT_SUCCESS)
     {
         switch ((char)rx_value)
         {
@@ -192,24 +791,154 @@ void radar_presence_terminal_ui(cy_thread_arg_t arg)
                 break;
             // presence range max
             case 'r':
-                printf("Enter range [0.66-10.2]m, press enter\n");
-                terminal_ui_readline(&cy_retarget_io_uart_obj, value, IFX_RADAR_SENSING_VALUE_MAXLENGTH);
-                terminal_ui_print_result(
-                    mtb_radar_sensing_set_parameter(&sensing_context, "radar_presence_range_max", value));
+                printf("Enter range [%.2f-%.2f]m, press enter\n",
+                       (double)radar_params_get_info(RADAR_PARAM_RANGE_MAX)->min,
+                       (double)radar_params_get_info(RADAR_PARAM_RANGE_MAX)->max);
+                if (terminal_ui_readline(&cy_retarget_io_uart_obj, value, IFX_RADAR_SENSING_VALUE_MAXLENGTH))
+                {
+                    terminal_ui_set_parameter(RADAR_PARAM_RANGE_MAX, value);
+                }
                 break;
             // sensitivity
             case 's':
                 printf("Set Sensitivity: 'high', 'medium' or 'low'\n");
-                terminal_ui_readline(&cy_retarget_io_uart_obj, value, IFX_RADAR_SENSING_VALUE_MAXLENGTH);
-                terminal_ui_print_result(
-                    mtb_radar_sensing_set_parameter(&sensing_context, "radar_presence_sensitivity", value));
+                if (terminal_ui_readline(&cy_retarget_io_uart_obj, value, IFX_RADAR_SENSING_VALUE_MAXLENGTH))
+                {
+                    terminal_ui_set_parameter(RADAR_PARAM_SENSITIVITY, value);
+                }
+                break;
+            // adaptive frame rate
+            case 'a':
+                terminal_ui_print_adaptive();
+                printf("Enter 'idle s,period ms,on ms', e.g. '60,2000,500', or '0' for off, press enter\n");
+                if (terminal_ui_readline(&cy_retarget_io_uart_obj, value, IFX_RADAR_SENSING_VALUE_MAXLENGTH))
+                {
+                    terminal_ui_set_adaptive(value);
+                }
+                break;
+            // telemetry interval
+            case 'd':
+                printf("Enter telemetry interval in ms [%u-%u], or '0' for off, press enter\n",
+                       (unsigned int)RADAR_TELEMETRY_MIN_INTERVAL_MS,
+                       (unsigned int)RADAR_TELEMETRY_MAX_INTERVAL_MS);
+                if (terminal_ui_readline(&cy_retarget_io_uart_obj, value, IFX_RADAR_SENSING_VALUE_MAXLENGTH))
+                {
+                    terminal_ui_set_telemetry(value);
+                }
+                break;
+            // presence hold time
+            case 'h':
+                terminal_ui_print_hold();
+                printf("Enter presence hold time in ms [0-%u], '0' for off, press enter\n",
+                       (unsigned int)RADAR_COALESCE_MAX_HOLD_MS);
+                if (terminal_ui_readline(&cy_retarget_io_uart_obj, value, IFX_RADAR_SENSING_VALUE_MAXLENGTH))
+                {
+                    terminal_ui_set_hold(value);
+                }
+                break;
+            // saved settings
+            case 'w':
+                printf("%s\n", radar_profile_save() ? "OK" : "ERROR");
+                break;
+            case 'W':
+                printf("%s\n", radar_profile_erase() ? "OK" : "ERROR");
+                break;
+            // event queue statistics
+            case 'e':
+                terminal_ui_print_event_stats();
+                break;
+            // binary event output
+            case 'b':
+                radar_event_log_set_binary(!radar_event_log_is_binary());
+                printf("Binary event output %s\n", radar_event_log_is_binary() ? "on" : "off");
+                break;
+            // boot phases
+            case 'i':
+                radar_presence_task_set_mute(true);
+                radar_boot_print();
+                radar_presence_task_set_mute(false);
+                break;
+            // sensing modes
+            case 'm':
+                radar_presence_task_set_mute(true);
+                radar_task_print_modes();
+                radar_presence_task_set_mute(false);
+                break;
+            // parameter sweep
+            case 'x':
+                printf("Enter frames per setting [%u-%u], press enter\n",
+                       (unsigned int)RADAR_SWEEP_MIN_FRAMES,
+                       (unsigned int)RADAR_SWEEP_MAX_FRAMES);
+                if (terminal_ui_readline(&cy_retarget_io_uart_obj, value, IFX_RADAR_SENSING_VALUE_MAXLENGTH))
+                {
+                    terminal_ui_sweep(value);
+                }
+                break;
+            // task statistics
+            case 't':
+                radar_presence_task_set_mute(true);
+                radar_stats_print_tasks();
+#if (RADAR_SENSOR_COUNT > 1)
+                radar_task_print_sensors();
+#endif
+#if (RADAR_TASK_PROCESS_MODE == RADAR_TASK_PROCESS_MODE_PERIODIC)
+                radar_task_print_period();
+#endif
+#if (RADAR_SPI_DMA_ENABLE == 1)
+                terminal_ui_print_spi_dma();
+#endif
+#if (RADAR_CONSOLE_TX_RING_ENABLE == 1) || (RADAR_CONSOLE_RX_RING_ENABLE == 1)
+                terminal_ui_print_console();
+#endif
+                radar_presence_task_set_mute(false);
+                break;
+#if (RADAR_LOW_POWER_ENABLE == 1) || (RADAR_LOAD_ENABLE == 1)
+            // sleep/active time and CPU load
+            case 'p':
+#if (RADAR_LOW_POWER_ENABLE == 1)
+                terminal_ui_print_power();
+#endif
+#if (RADAR_LOAD_ENABLE == 1)
+                terminal_ui_print_load();
+#endif
+                break;
+#endif
+#if (RADAR_PROFILER_ENABLE == 1)
+            // processing cycle profile
+            case 'c':
+                radar_presence_task_set_mute(true);
+                radar_profiler_print();
+                radar_presence_task_set_mute(false);
+                break;
+            case 'C':
+                radar_profiler_reset();
+                printf("OK\n");
+                break;
+#endif
+#if (RADAR_LATENCY_ENABLE == 1)
+            // IRQ-to-output latency
+            case 'l':
+                radar_presence_task_set_mute(true);
+                radar_latency_print();
+                radar_presence_task_set_mute(false);
+                break;
+            case 'L':
+                radar_latency_reset();
+                printf("OK\n");
+                break;
+#endif
+#if (RADAR_CAPTURE_ENABLE == 1)
+            // raw frame capture
+            case 'f':
+                terminal_ui_toggle_capture();
                 break;
+#endif
             default:
                 terminal_ui_info();
         }
         rx_value = 0;
     }
     printf("Exiting terminal ui\n");
-    /* Exit current thread (suspend) */
-    (void)cy_rtos_exit_thread();
+    /* Exit current thread */
+    radar_rtos_exit_thread();
 }
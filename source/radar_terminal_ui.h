@@ -36,7 +36,9 @@
 /* Stack size for radar presence terminal ui */
 #define RADAR_PRESENCE_TERMINAL_UI_TASK_STACK_SIZE (2048)
 /* Priority number for radar presence terminal ui */
+#ifndef RADAR_PRESENCE_TERMINAL_UI_TASK_PRIORITY
 #define RADAR_PRESENCE_TERMINAL_UI_TASK_PRIORITY (CY_RTOS_PRIORITY_BELOWNORMAL)
+#endif
 
 /*******************************************************************************
  * Functions
@@ -0,0 +1,134 @@
+/*****************************************************************************
+** File name: radar_time.c
+**
+** Description: This file implements the microsecond clock of the radar
+** presence application. A free-running 32-bit hardware timer counts at 1 MHz
+** and is extended to 64 bits in software. The timer stops in deep sleep, so
+** the sleep time measured by the low power timer is added back on wakeup.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file includes */
+#include "cy_pdl.h"
+#include "cyhal.h"
+
+/* Header file for local module */
+#include "radar_time.h"
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static cyhal_timer_t time_timer;
+/* Time in us up to the last timer value seen by radar_time_us() */
+static uint64_t time_base_us;
+static uint32_t time_last_count;
+
+/*******************************************************************************
+ * Function Name: radar_time_init
+ ********************************************************************************
+ * Summary:
+ *   Starts the timestamp timer. Must be called before the scheduler starts.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_time_init(void)
+{
+    const cyhal_timer_cfg_t timer_cfg =
+    {
+        .is_continuous = true,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .period = UINT32_MAX,
+        .compare_value = 0,
+        .value = 0
+    };
+
+    if (cyhal_timer_init(&time_timer, NC, NULL) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    if (cyhal_timer_configure(&time_timer, &timer_cfg) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    if (cyhal_timer_set_frequency(&time_timer, RADAR_TIME_FREQUENCY) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+    if (cyhal_timer_start(&time_timer) != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: radar_time_us
+ ********************************************************************************
+ * Summary:
+ *   Returns the time since radar_time_init() in us. The 32-bit timer wraps
+ *   after 71 minutes, a wrap is detected as long as the clock is read at
+ *   least once in that interval, which the radar task does every frame. Can
+ *   be called from tasks and interrupts.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   time in us
+ *******************************************************************************/
+uint64_t radar_time_us(void)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    uint32_t count = cyhal_timer_read(&time_timer);
+
+    /* Unsigned difference, also correct across a wrap */
+    time_base_us += (uint32_t)(count - time_last_count);
+    time_last_count = count;
+
+    uint64_t now = time_base_us;
+    Cy_SysLib_ExitCriticalSection(status);
+
+    return now;
+}
+
+/*******************************************************************************
+ * Function Name: radar_time_add_sleep
+ ********************************************************************************
+ * Summary:
+ *   Adds the time spent in deep sleep, during which the timer did not count.
+ *   Called by the idle task, on wakeup from deep sleep.
+ *
+ * Parameters:
+ *   sleep_ms: time spent in deep sleep
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void radar_time_add_sleep(uint32_t sleep_ms)
+{
+    uint32_t status = Cy_SysLib_EnterCriticalSection();
+    time_base_us += (uint64_t)sleep_ms * 1000U;
+    Cy_SysLib_ExitCriticalSection(status);
+}
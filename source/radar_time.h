@@ -0,0 +1,60 @@
+/******************************************************************************
+** File name: radar_time.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in radar_time.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdint.h>
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Frequency of the timestamp timer, one count per microsecond */
+#define RADAR_TIME_FREQUENCY (1000000UL)
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void radar_time_init(void);
+uint64_t radar_time_us(void);
+void radar_time_add_sleep(uint32_t sleep_ms);
+
+/*******************************************************************************
+ * Function Name: radar_time_ms
+ ********************************************************************************
+ * Summary:
+ *   Returns the time since radar_time_init() in ms
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   time in ms
+ *******************************************************************************/
+static inline uint64_t radar_time_ms(void)
+{
+    return radar_time_us() / 1000U;
+}
@@ -0,0 +1,246 @@
+/*****************************************************************************
+** File name: capture_reader.c
+**
+** Description: This file reads the records of a raw frame capture as written
+** by radar_stream.c on the device: the stream is split at the zero delimiters,
+** every chunk is COBS decoded and kept if its CRC-16 matches. Console text
+** between the records does not pass the CRC and is skipped.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file from system */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Header file for local module */
+#include "capture_reader.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Must match radar_stream.c */
+#define CAPTURE_CRC_INIT (0xFFFFU)
+#define CAPTURE_CRC_POLY (0x1021U)
+#define CAPTURE_DELIMITER (0x00U)
+/* COBS code byte of a full block, which has no implied zero */
+#define CAPTURE_COBS_FULL (0xFFU)
+/* Type byte and CRC */
+#define CAPTURE_OVERHEAD (3U)
+
+/*******************************************************************************
+ * Function Name: capture_reader_crc
+ ********************************************************************************
+ * Summary:
+ *   Computes the CRC-16/CCITT-FALSE of a buffer
+ *
+ * Parameters:
+ *   data: bytes
+ *   length: number of bytes
+ *
+ * Return:
+ *   CRC
+ *******************************************************************************/
+static uint16_t capture_reader_crc(const uint8_t *data, size_t length)
+{
+    uint16_t crc = CAPTURE_CRC_INIT;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8);
+        for (uint32_t bit = 0; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1) ^ CAPTURE_CRC_POLY) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+ * Function Name: capture_reader_decode
+ ********************************************************************************
+ * Summary:
+ *   COBS decodes one chunk
+ *
+ * Parameters:
+ *   input: encoded chunk, without delimiters
+ *   length: number of bytes
+ *   output: decoded bytes, at least length bytes
+ *
+ * Return:
+ *   number of decoded bytes, or 0 if the chunk is not valid COBS
+ *******************************************************************************/
+static size_t capture_reader_decode(const uint8_t *input, size_t length, uint8_t *output)
+{
+    size_t in = 0U;
+    size_t out = 0U;
+
+    while (in < length)
+    {
+        uint8_t code = input[in++];
+
+        if ((size_t)(code - 1U) > (length - in))
+        {
+            return 0U;
+        }
+        for (uint32_t i = 1U; i < code; i++)
+        {
+            output[out++] = input[in++];
+        }
+        if ((code != CAPTURE_COBS_FULL) && (in < length))
+        {
+            output[out++] = 0U;
+        }
+    }
+
+    return out;
+}
+
+/*******************************************************************************
+ * Function Name: capture_reader_open
+ ********************************************************************************
+ * Summary:
+ *   Loads a capture file
+ *
+ * Parameters:
+ *   reader: reader state
+ *   path: file name
+ *
+ * Return:
+ *   true if the file has been loaded
+ *******************************************************************************/
+bool capture_reader_open(capture_reader_t *reader, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    long size;
+
+    *reader = (capture_reader_t){ 0 };
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < 0) || (fseek(file, 0, SEEK_SET) != 0))
+    {
+        fclose(file);
+        return false;
+    }
+
+    reader->size = (size_t)size;
+    reader->data = malloc(reader->size + 1U);
+    reader->decoded = malloc(reader->size + 1U);
+    if ((reader->data == NULL) || (reader->decoded == NULL) ||
+        (fread(reader->data, 1U, reader->size, file) != reader->size))
+    {
+        fclose(file);
+        capture_reader_close(reader);
+        return false;
+    }
+
+    fclose(file);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: capture_reader_next
+ ********************************************************************************
+ * Summary:
+ *   Returns the next record with a valid CRC
+ *
+ * Parameters:
+ *   reader: reader state
+ *   record: decoded record
+ *
+ * Return:
+ *   false at the end of the file
+ *******************************************************************************/
+bool capture_reader_next(capture_reader_t *reader, capture_record_t *record)
+{
+    while (reader->offset < reader->size)
+    {
+        const uint8_t *chunk = &reader->data[reader->offset];
+        size_t length = 0U;
+
+        while (((reader->offset + length) < reader->size) && (chunk[length] != CAPTURE_DELIMITER))
+        {
+            length++;
+        }
+        reader->offset += length + 1U;
+
+        if (length == 0U)
+        {
+            continue;
+        }
+
+        size_t decoded = capture_reader_decode(chunk, length, reader->decoded);
+        if ((decoded < CAPTURE_OVERHEAD) ||
+            (capture_reader_crc(reader->decoded, decoded - 2U) !=
+             (uint16_t)(((uint16_t)reader->decoded[decoded - 2U] << 8) | reader->decoded[decoded - 1U])))
+        {
+            reader->rejected++;
+            continue;
+        }
+
+        record->type = reader->decoded[0];
+        record->payload = &reader->decoded[1];
+        record->length = decoded - CAPTURE_OVERHEAD;
+        reader->records++;
+        return true;
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+ * Function Name: capture_reader_rewind
+ ********************************************************************************
+ * Summary:
+ *   Restarts reading at the beginning of the file
+ *
+ * Parameters:
+ *   reader: reader state
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void capture_reader_rewind(capture_reader_t *reader)
+{
+    reader->offset = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: capture_reader_close
+ ********************************************************************************
+ * Summary:
+ *   Releases the file content
+ *
+ * Parameters:
+ *   reader: reader state
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void capture_reader_close(capture_reader_t *reader)
+{
+    free(reader->data);
+    free(reader->decoded);
+    *reader = (capture_reader_t){ 0 };
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+** File name: capture_reader.h
+**
+** Description: This file contains the function prototypes and types used
+**   in capture_reader.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+/* Decoded record, the payload stays valid until the next call of
+   capture_reader_next() */
+typedef struct
+{
+    uint8_t type;
+    const uint8_t *payload;
+    size_t length;
+} capture_record_t;
+
+typedef struct
+{
+    uint8_t *data;     /* Content of the capture file */
+    size_t size;
+    size_t offset;     /* Start of the next chunk */
+    uint8_t *decoded;  /* Decoded chunk */
+    uint32_t records;  /* Records with a valid CRC */
+    uint32_t rejected; /* Chunks that are not a valid record, e.g. console text */
+} capture_reader_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+bool capture_reader_open(capture_reader_t *reader, const char *path);
+bool capture_reader_next(capture_reader_t *reader, capture_record_t *record);
+void capture_reader_rewind(capture_reader_t *reader);
+void capture_reader_close(capture_reader_t *reader);
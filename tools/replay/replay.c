@@ -0,0 +1,572 @@
+/*****************************************************************************
+** File name: replay.c
+**
+** Description: This file replays a raw frame capture through the
+** RadarSensing presence pipeline on the host. Frames are fed to
+** mtb_radar_sensing_process() with their recorded timestamps as a virtual
+** clock, the events are printed in the format of the device and every
+** process call is timed to report the throughput and latency of the pipeline.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file from system */
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Header file includes */
+#include "mtb_radar_sensing.h"
+
+/* Header file for local module */
+#include "capture_reader.h"
+#include "radar_stream.h"
+#include "replay_hal.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Must match radar_capture.c */
+#define REPLAY_PARAMS_HEADER_SIZE (4U)
+#define REPLAY_FRAME_HEADER_SIZE (11U)
+#define REPLAY_FLAG_TRUNCATED (0x01U)
+/* Longest parameter line of a CAPTURE_PARAMS record */
+#define REPLAY_PARAM_MAXLENGTH (128U)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint32_t frames;
+    uint32_t truncated;
+    uint32_t dropped;       /* Frames dropped on the device, from the frame headers */
+    uint32_t sequence_gaps; /* Frames lost on the link, from the sequence numbers */
+    uint32_t params;
+    uint32_t events_in;
+    uint32_t events_out;
+    uint32_t counter_events;
+    uint32_t errors;
+    uint32_t processed;     /* Process calls, frames before the first parameter
+                               record are not processed */
+    double *latency_us;     /* Duration of every process call */
+    uint32_t latency_size;
+    double total_us;
+} replay_stats_t;
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static mtb_radar_sensing_context_t sensing_context;
+static cyhal_spi_t replay_spi;
+static replay_stats_t replay_stats;
+static bool replay_quiet;
+static bool replay_enabled;
+
+/*******************************************************************************
+ * Function Name: replay_get_u32
+ ********************************************************************************
+ * Summary:
+ *   Reads a little endian 32-bit value
+ *
+ * Parameters:
+ *   data: 4 bytes
+ *
+ * Return:
+ *   value
+ *******************************************************************************/
+static uint32_t replay_get_u32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/*******************************************************************************
+ * Function Name: replay_now_us
+ ********************************************************************************
+ * Summary:
+ *   Reads the monotonic host clock
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   time in us
+ *******************************************************************************/
+static double replay_now_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((double)now.tv_sec * 1e6) + ((double)now.tv_nsec / 1e3);
+}
+
+/*******************************************************************************
+ * Function Name: replay_sensing_callback
+ ********************************************************************************
+ * Summary:
+ *   Counts and prints the events of the library, in the format of
+ *   radar_event_log.c
+ *
+ * Parameters:
+ *   context: library context
+ *   event: event
+ *   event_info: event details
+ *   data: not used
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void replay_sensing_callback(mtb_radar_sensing_context_t *context,
+                                    mtb_radar_sensing_event_t event,
+                                    mtb_radar_sensing_event_info_t *event_info,
+                                    void *data)
+{
+    (void)context;
+    (void)data;
+
+    switch (event)
+    {
+        case MTB_RADAR_SENSING_EVENT_PRESENCE_IN:
+            replay_stats.events_in++;
+            if (!replay_quiet)
+            {
+                const mtb_radar_sensing_presence_event_info_t *info =
+                    (const mtb_radar_sensing_presence_event_info_t *)event_info;
+                printf("%" PRIu64 ".%03" PRIu64 "000: Presence IN %.2f-%.2f\n",
+                       event_info->timestamp / 1000U,
+                       event_info->timestamp % 1000U,
+                       info->distance - info->accuracy,
+                       info->distance + info->accuracy);
+            }
+            break;
+
+        case MTB_RADAR_SENSING_EVENT_PRESENCE_OUT:
+            replay_stats.events_out++;
+            if (!replay_quiet)
+            {
+                printf("%" PRIu64 ".%03" PRIu64 "000: Presence OUT\n",
+                       event_info->timestamp / 1000U,
+                       event_info->timestamp % 1000U);
+            }
+            break;
+
+        case MTB_RADAR_SENSING_EVENT_COUNTER_IN:
+        case MTB_RADAR_SENSING_EVENT_COUNTER_OUT:
+            replay_stats.counter_events++;
+            if (!replay_quiet)
+            {
+                const mtb_radar_sensing_counter_event_info_t *info =
+                    (const mtb_radar_sensing_counter_event_info_t *)event_info;
+                printf("%" PRIu64 ".%03" PRIu64 "000: Counter %s, in %" PRIu32 " out %" PRIu32 "\n",
+                       event_info->timestamp / 1000U,
+                       event_info->timestamp % 1000U,
+                       (event == MTB_RADAR_SENSING_EVENT_COUNTER_IN) ? "IN" : "OUT",
+                       info->in_count,
+                       info->out_count);
+            }
+            break;
+
+        case MTB_RADAR_SENSING_EVENT_COUNTER_OCCUPIED:
+        case MTB_RADAR_SENSING_EVENT_COUNTER_FREE:
+            replay_stats.counter_events++;
+            if (!replay_quiet)
+            {
+                printf("%" PRIu64 ".%03" PRIu64 "000: Room %s\n",
+                       event_info->timestamp / 1000U,
+                       event_info->timestamp % 1000U,
+                       (event == MTB_RADAR_SENSING_EVENT_COUNTER_OCCUPIED) ? "occupied" : "free");
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: replay_apply_parameters
+ ********************************************************************************
+ * Summary:
+ *   Applies a CAPTURE_PARAMS record. The library is disabled around the
+ *   update if it is already running, as radar_task.c does.
+ *
+ * Parameters:
+ *   payload: record payload
+ *   length: payload length
+ *
+ * Return:
+ *   true if all parameters were accepted
+ *******************************************************************************/
+static bool replay_apply_parameters(const uint8_t *payload, size_t length)
+{
+    bool ok = true;
+    size_t offset = REPLAY_PARAMS_HEADER_SIZE;
+
+    if (length < REPLAY_PARAMS_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    if (replay_enabled)
+    {
+        (void)mtb_radar_sensing_disable(&sensing_context);
+    }
+
+    while (offset < length)
+    {
+        char line[REPLAY_PARAM_MAXLENGTH];
+        size_t end = offset;
+
+        while ((end < length) && (payload[end] != '\n'))
+        {
+            end++;
+        }
+
+        if ((end - offset) < sizeof(line))
+        {
+            memcpy(line, &payload[offset], end - offset);
+            line[end - offset] = '\0';
+
+            char *value = strchr(line, '=');
+            if (value != NULL)
+            {
+                *value++ = '\0';
+                if (mtb_radar_sensing_set_parameter(&sensing_context, line, value) != MTB_RADAR_SENSING_SUCCESS)
+                {
+                    fprintf(stderr, "Parameter rejected: %s=%s\n", line, value);
+                    ok = false;
+                }
+                else if (!replay_quiet)
+                {
+                    printf("%s=%s\n", line, value);
+                }
+            }
+        }
+        offset = end + 1U;
+    }
+
+    if (mtb_radar_sensing_enable(&sensing_context) != MTB_RADAR_SENSING_SUCCESS)
+    {
+        fprintf(stderr, "Enabling the sensing failed\n");
+        return false;
+    }
+    replay_enabled = true;
+    replay_stats.params++;
+
+    return ok;
+}
+
+/*******************************************************************************
+ * Function Name: replay_process_frame
+ ********************************************************************************
+ * Summary:
+ *   Feeds a CAPTURE_FRAME record to the library and times the process call
+ *
+ * Parameters:
+ *   payload: record payload
+ *   length: payload length
+ *   time_offset: added to the recorded timestamp, keeps the virtual clock
+ *                monotonic when the capture is repeated
+ *   last_sequence: sequence number of the previous frame, updated
+ *
+ * Return:
+ *   recorded timestamp of the frame in ms
+ *******************************************************************************/
+static uint32_t replay_process_frame(const uint8_t *payload, size_t length, uint64_t time_offset,
+                                     int64_t *last_sequence)
+{
+    uint32_t sequence = replay_get_u32(&payload[0]);
+    uint32_t timestamp = replay_get_u32(&payload[4]);
+    uint32_t dropped = (uint32_t)payload[8] | ((uint32_t)payload[9] << 8);
+
+    if ((*last_sequence >= 0) && (sequence != (uint32_t)(*last_sequence + 1)))
+    {
+        replay_stats.sequence_gaps++;
+    }
+    *last_sequence = sequence;
+
+    replay_stats.frames++;
+    replay_stats.dropped += dropped;
+    if ((payload[10] & REPLAY_FLAG_TRUNCATED) != 0U)
+    {
+        replay_stats.truncated++;
+    }
+
+    /* The library does not run until the first parameter record, which the
+       device sends ahead of every capture */
+    if (!replay_enabled)
+    {
+        return timestamp;
+    }
+
+    replay_hal_load_frame(&payload[REPLAY_FRAME_HEADER_SIZE], length - REPLAY_FRAME_HEADER_SIZE);
+
+    double start = replay_now_us();
+    mtb_radar_sensing_result_t result = mtb_radar_sensing_process(&sensing_context, time_offset + timestamp);
+    double duration = replay_now_us() - start;
+
+    if (result != MTB_RADAR_SENSING_SUCCESS)
+    {
+        replay_stats.errors++;
+    }
+
+    if (replay_stats.processed >= replay_stats.latency_size)
+    {
+        replay_stats.latency_size = (replay_stats.latency_size == 0U) ? 1024U : (replay_stats.latency_size * 2U);
+        replay_stats.latency_us = realloc(replay_stats.latency_us,
+                                          replay_stats.latency_size * sizeof(replay_stats.latency_us[0]));
+        if (replay_stats.latency_us == NULL)
+        {
+            fprintf(stderr, "Out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    replay_stats.latency_us[replay_stats.processed++] = duration;
+    replay_stats.total_us += duration;
+
+    return timestamp;
+}
+
+/*******************************************************************************
+ * Function Name: replay_compare
+ ********************************************************************************
+ * Summary:
+ *   Orders two latencies for qsort()
+ *
+ * Parameters:
+ *   a: first latency
+ *   b: second latency
+ *
+ * Return:
+ *   -1, 0 or 1
+ *******************************************************************************/
+static int replay_compare(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*******************************************************************************
+ * Function Name: replay_print_summary
+ ********************************************************************************
+ * Summary:
+ *   Prints the counters, the throughput and the latency percentiles of the
+ *   process calls
+ *
+ * Parameters:
+ *   reader: capture reader
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void replay_print_summary(const capture_reader_t *reader)
+{
+    replay_hal_stats_t hal;
+    uint32_t timed = replay_stats.processed;
+
+    replay_hal_get_stats(&hal);
+
+    printf("Records: %" PRIu32 " (%" PRIu32 " chunks rejected)\n", reader->records, reader->rejected);
+    printf("Frames: %" PRIu32 " (%" PRIu32 " truncated, %" PRIu32 " dropped on the device, %" PRIu32
+           " sequence gaps)\n",
+           replay_stats.frames, replay_stats.truncated, replay_stats.dropped, replay_stats.sequence_gaps);
+    printf("Parameter records: %" PRIu32 "\n", replay_stats.params);
+    printf("Events: %" PRIu32 " IN, %" PRIu32 " OUT, %" PRIu32 " counter\n",
+           replay_stats.events_in, replay_stats.events_out, replay_stats.counter_events);
+    printf("Process errors: %" PRIu32 "\n", replay_stats.errors);
+    printf("FIFO: %" PRIu64 " B read, %" PRIu64 " B underrun, %" PRIu64 " B unread\n",
+           hal.fifo_bytes, hal.underrun_bytes, hal.unread_bytes);
+
+    if ((timed == 0U) || (replay_stats.total_us <= 0.0))
+    {
+        return;
+    }
+
+    qsort(replay_stats.latency_us, timed, sizeof(replay_stats.latency_us[0]), replay_compare);
+    printf("Throughput: %.1f frames/s\n", (double)timed * 1e6 / replay_stats.total_us);
+    printf("Latency (us): min %.1f mean %.1f p50 %.1f p99 %.1f max %.1f\n",
+           replay_stats.latency_us[0],
+           replay_stats.total_us / (double)timed,
+           replay_stats.latency_us[(timed - 1U) / 2U],
+           replay_stats.latency_us[((timed - 1U) * 99U) / 100U],
+           replay_stats.latency_us[timed - 1U]);
+}
+
+/*******************************************************************************
+ * Function Name: replay_parse_modes
+ ********************************************************************************
+ * Summary:
+ *   Parses the use cases of the -m option, a comma-separated list of
+ *   'presence' and 'counter', as the RADAR_MODES build option of the
+ *   application selects them.
+ *
+ * Parameters:
+ *   list: option argument
+ *
+ * Return:
+ *   event mask of the use cases, 0 if the list is invalid
+ *******************************************************************************/
+static mtb_radar_sensing_mask_t replay_parse_modes(char *list)
+{
+    mtb_radar_sensing_mask_t modes = 0U;
+
+    for (char *mode = strtok(list, ","); mode != NULL; mode = strtok(NULL, ","))
+    {
+        if (strcmp(mode, "presence") == 0)
+        {
+            modes |= MTB_RADAR_SENSING_MASK_PRESENCE_EVENTS;
+        }
+        else if (strcmp(mode, "counter") == 0)
+        {
+            modes |= MTB_RADAR_SENSING_MASK_COUNTER_EVENTS;
+        }
+        else
+        {
+            return 0U;
+        }
+    }
+
+    return modes;
+}
+
+/*******************************************************************************
+ * Function Name: main
+ ********************************************************************************
+ * Summary:
+ *   Parses the command line, initializes the library on the emulated radar
+ *   and replays the capture.
+ *
+ * Parameters:
+ *   argc: number of arguments
+ *   argv: arguments
+ *
+ * Return:
+ *   EXIT_SUCCESS if the capture has been replayed without errors
+ *******************************************************************************/
+int main(int argc, char *argv[])
+{
+    capture_reader_t reader;
+    capture_record_t record;
+    uint32_t repeat = 1U;
+    uint64_t time_offset = 0U;
+    uint32_t last_timestamp = 0U;
+    mtb_radar_sensing_mask_t modes = MTB_RADAR_SENSING_MASK_PRESENCE_EVENTS;
+    int option;
+
+    while ((option = getopt(argc, argv, "qn:m:")) != -1)
+    {
+        switch (option)
+        {
+            case 'q':
+                replay_quiet = true;
+                break;
+
+            case 'n':
+                repeat = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'm':
+                modes = replay_parse_modes(optarg);
+                break;
+
+            default:
+                fprintf(stderr, "Usage: %s [-q] [-n repeat] [-m modes] capture.bin\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if ((optind >= argc) || (repeat == 0U) || (modes == 0U))
+    {
+        fprintf(stderr, "Usage: %s [-q] [-n repeat] [-m modes] capture.bin\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!capture_reader_open(&reader, argv[optind]))
+    {
+        fprintf(stderr, "Cannot read %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    replay_hal_init(REPLAY_CHIP_ID_DEFAULT);
+
+    mtb_radar_sensing_hw_cfg_t hw_cfg =
+    {
+        .spi_cs = REPLAY_PIN_SPI_CS,
+        .reset = REPLAY_PIN_RESET,
+        .ldo_en = REPLAY_PIN_LDO_EN,
+        .irq = REPLAY_PIN_IRQ,
+        .spi = &replay_spi
+    };
+
+    if ((mtb_radar_sensing_init(&sensing_context, &hw_cfg, modes) !=
+         MTB_RADAR_SENSING_SUCCESS) ||
+        (mtb_radar_sensing_register_callback(&sensing_context, replay_sensing_callback, NULL) !=
+         MTB_RADAR_SENSING_SUCCESS))
+    {
+        fprintf(stderr, "Initializing the sensing failed\n");
+        capture_reader_close(&reader);
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t run = 0; run < repeat; run++)
+    {
+        int64_t last_sequence = -1;
+
+        capture_reader_rewind(&reader);
+        while (capture_reader_next(&reader, &record))
+        {
+            switch (record.type)
+            {
+                case RADAR_STREAM_TYPE_CAPTURE_PARAMS:
+                    /* Parameters are only needed once, the library keeps
+                       them over repeated runs */
+                    if ((run == 0U) && !replay_apply_parameters(record.payload, record.length))
+                    {
+                        replay_stats.errors++;
+                    }
+                    break;
+
+                case RADAR_STREAM_TYPE_CAPTURE_FRAME:
+                    if (record.length >= REPLAY_FRAME_HEADER_SIZE)
+                    {
+                        last_timestamp = replay_process_frame(record.payload, record.length, time_offset,
+                                                              &last_sequence);
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+        time_offset += (uint64_t)last_timestamp + 1U;
+    }
+
+    replay_print_summary(&reader);
+
+    free(replay_stats.latency_us);
+    capture_reader_close(&reader);
+
+    return (replay_stats.errors == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,392 @@
+/*****************************************************************************
+** File name: replay_hal.c
+**
+** Description: This file emulates the radar behind the SPI and GPIO HAL
+** functions for the replay harness. Register writes are stored in a register
+** file and read back, FIFO bursts are served from the recorded frame data,
+** and the IRQ pin is high while recorded data is left. Delays return at once,
+** time is only advanced by the virtual clock of replay.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file from system */
+#include <string.h>
+
+/* Header file for local module */
+#include "replay_hal.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* A register access is a 32-bit word: address (7 bits), write flag (1 bit)
+   and data (24 bits), most significant byte first. The radar answers with
+   its status byte followed by the register content. */
+#define REPLAY_WORD_SIZE (4U)
+
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+static uint32_t registers[REPLAY_REGISTERS];
+static const uint8_t *fifo_data;
+static size_t fifo_length;
+static size_t fifo_offset;
+static replay_hal_stats_t hal_stats;
+
+/*******************************************************************************
+ * Function Name: replay_hal_init
+ ********************************************************************************
+ * Summary:
+ *   Resets the emulated radar
+ *
+ * Parameters:
+ *   chip_id: value of the CHIP_ID register
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void replay_hal_init(uint32_t chip_id)
+{
+    memset(registers, 0, sizeof(registers));
+    memset(&hal_stats, 0, sizeof(hal_stats));
+    registers[REPLAY_REG_CHIP_ID] = chip_id;
+    fifo_data = NULL;
+    fifo_length = 0U;
+    fifo_offset = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: replay_hal_load_frame
+ ********************************************************************************
+ * Summary:
+ *   Makes the FIFO data of a recorded frame available to the library.
+ *   Recorded data of the previous frame that was not read is discarded.
+ *
+ * Parameters:
+ *   data: FIFO data, must stay valid until the next call
+ *   length: number of bytes
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void replay_hal_load_frame(const uint8_t *data, size_t length)
+{
+    hal_stats.unread_bytes += fifo_length - fifo_offset;
+    fifo_data = data;
+    fifo_length = length;
+    fifo_offset = 0U;
+}
+
+/*******************************************************************************
+ * Function Name: replay_hal_pending
+ ********************************************************************************
+ * Summary:
+ *   Returns the number of recorded FIFO bytes not read yet
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   number of bytes
+ *******************************************************************************/
+size_t replay_hal_pending(void)
+{
+    return fifo_length - fifo_offset;
+}
+
+/*******************************************************************************
+ * Function Name: replay_hal_get_stats
+ ********************************************************************************
+ * Summary:
+ *   Returns the counters of the emulated radar
+ *
+ * Parameters:
+ *   stats: counters
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void replay_hal_get_stats(replay_hal_stats_t *stats)
+{
+    *stats = hal_stats;
+}
+
+/*******************************************************************************
+ * Function Name: replay_hal_register_access
+ ********************************************************************************
+ * Summary:
+ *   Executes the register access words of a short SPI transfer
+ *
+ * Parameters:
+ *   tx: transmitted words
+ *   rx: buffer for the answer, or NULL
+ *   length: transfer length in bytes
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void replay_hal_register_access(const uint8_t *tx, uint8_t *rx, size_t length)
+{
+    for (size_t i = 0; (i + REPLAY_WORD_SIZE) <= length; i += REPLAY_WORD_SIZE)
+    {
+        uint32_t address = (uint32_t)tx[i] >> 1;
+        uint32_t value = registers[address];
+
+        if ((tx[i] & 0x01U) != 0U)
+        {
+            registers[address] = ((uint32_t)tx[i + 1U] << 16) | ((uint32_t)tx[i + 2U] << 8) | tx[i + 3U];
+            hal_stats.register_writes++;
+        }
+        else
+        {
+            hal_stats.register_reads++;
+        }
+
+        if (rx != NULL)
+        {
+            rx[i] = 0U;
+            rx[i + 1U] = (uint8_t)(value >> 16);
+            rx[i + 2U] = (uint8_t)(value >> 8);
+            rx[i + 3U] = (uint8_t)value;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_spi_transfer
+ ********************************************************************************
+ * Summary:
+ *   Emulates an SPI transfer with the radar. Long reads return the recorded
+ *   FIFO data, short transfers are register accesses.
+ *
+ * Parameters:
+ *   obj: SPI block
+ *   tx: bytes to transmit
+ *   tx_length: number of bytes to transmit
+ *   rx: buffer for the received bytes
+ *   rx_length: number of bytes to receive
+ *   write_fill: not used
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS
+ *******************************************************************************/
+cy_rslt_t cyhal_spi_transfer(cyhal_spi_t *obj, const uint8_t *tx, size_t tx_length, uint8_t *rx, size_t rx_length, uint8_t write_fill)
+{
+    (void)obj;
+    (void)write_fill;
+
+    if ((rx != NULL) && (rx_length >= REPLAY_FIFO_MIN_BURST))
+    {
+        size_t available = fifo_length - fifo_offset;
+        size_t length = (rx_length < available) ? rx_length : available;
+
+        if (length > 0U)
+        {
+            memcpy(rx, &fifo_data[fifo_offset], length);
+        }
+        memset(&rx[length], 0, rx_length - length);
+        fifo_offset += length;
+        hal_stats.fifo_bytes += length;
+        hal_stats.underrun_bytes += rx_length - length;
+        return CY_RSLT_SUCCESS;
+    }
+
+    if (tx != NULL)
+    {
+        replay_hal_register_access(tx, rx, tx_length);
+    }
+    else if (rx != NULL)
+    {
+        memset(rx, 0, rx_length);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_spi_send
+ ********************************************************************************
+ * Summary:
+ *   Emulates a single-word SPI write, the radar ignores it
+ *
+ * Parameters:
+ *   obj: SPI block
+ *   value: word to transmit
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS
+ *******************************************************************************/
+cy_rslt_t cyhal_spi_send(cyhal_spi_t *obj, uint32_t value)
+{
+    (void)obj;
+    (void)value;
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_spi_recv
+ ********************************************************************************
+ * Summary:
+ *   Emulates a single-word SPI read, the radar answers with zero
+ *
+ * Parameters:
+ *   obj: SPI block
+ *   value: received word
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS
+ *******************************************************************************/
+cy_rslt_t cyhal_spi_recv(cyhal_spi_t *obj, uint32_t *value)
+{
+    (void)obj;
+    *value = 0U;
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_gpio_init
+ ********************************************************************************
+ * Summary:
+ *   Emulates the pin setup, nothing to do
+ *
+ * Parameters:
+ *   pin: pin
+ *   direction: not used
+ *   drive_mode: not used
+ *   init_val: not used
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS
+ *******************************************************************************/
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction, cyhal_gpio_drive_mode_t drive_mode, bool init_val)
+{
+    (void)pin;
+    (void)direction;
+    (void)drive_mode;
+    (void)init_val;
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_gpio_free
+ ********************************************************************************
+ * Summary:
+ *   Emulates releasing a pin, nothing to do
+ *
+ * Parameters:
+ *   pin: pin
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void cyhal_gpio_free(cyhal_gpio_t pin)
+{
+    (void)pin;
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_gpio_write
+ ********************************************************************************
+ * Summary:
+ *   Emulates writing an output pin (reset, LDO enable, chip select), the
+ *   emulated radar ignores it
+ *
+ * Parameters:
+ *   pin: pin
+ *   value: pin level
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value)
+{
+    (void)pin;
+    (void)value;
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_gpio_read
+ ********************************************************************************
+ * Summary:
+ *   Emulates reading a pin. The IRQ pin is high while recorded FIFO data is
+ *   left, all other pins read low.
+ *
+ * Parameters:
+ *   pin: pin
+ *
+ * Return:
+ *   pin level
+ *******************************************************************************/
+bool cyhal_gpio_read(cyhal_gpio_t pin)
+{
+    return (pin == REPLAY_PIN_IRQ) && (replay_hal_pending() > 0U);
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_gpio_toggle
+ ********************************************************************************
+ * Summary:
+ *   Emulates toggling an output pin, the emulated radar ignores it
+ *
+ * Parameters:
+ *   pin: pin
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void cyhal_gpio_toggle(cyhal_gpio_t pin)
+{
+    (void)pin;
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_system_delay_ms
+ ********************************************************************************
+ * Summary:
+ *   Delays return at once, the replay runs on a virtual clock
+ *
+ * Parameters:
+ *   milliseconds: not used
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS
+ *******************************************************************************/
+cy_rslt_t cyhal_system_delay_ms(uint32_t milliseconds)
+{
+    (void)milliseconds;
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: cyhal_system_delay_us
+ ********************************************************************************
+ * Summary:
+ *   Delays return at once, the replay runs on a virtual clock
+ *
+ * Parameters:
+ *   microseconds: not used
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+void cyhal_system_delay_us(uint16_t microseconds)
+{
+    (void)microseconds;
+}
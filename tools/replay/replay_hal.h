@@ -0,0 +1,73 @@
+/******************************************************************************
+** File name: replay_hal.h
+**
+** Description: This file contains the function prototypes and constants used
+**   in replay_hal.c.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stddef.h>
+#include <stdint.h>
+
+/* Header file includes */
+#include "cyhal.h"
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+/* Pins of the emulated radar, any distinct values will do */
+#define REPLAY_PIN_SPI_CS ((cyhal_gpio_t)1U)
+#define REPLAY_PIN_RESET ((cyhal_gpio_t)2U)
+#define REPLAY_PIN_LDO_EN ((cyhal_gpio_t)3U)
+#define REPLAY_PIN_IRQ ((cyhal_gpio_t)4U)
+
+/* SPI reads of at least this many bytes are served from the recorded FIFO
+   data, the same threshold as RADAR_CAPTURE_MIN_BURST on the device */
+#define REPLAY_FIFO_MIN_BURST (64U)
+
+/* Registers of the emulated radar */
+#define REPLAY_REGISTERS (128U)
+#define REPLAY_REG_CHIP_ID (0x02U)
+/* CHIP_ID of a BGT60TR13C, digital ID 3 and RF ID 3 */
+#define REPLAY_CHIP_ID_DEFAULT (0x000303UL)
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef struct
+{
+    uint64_t fifo_bytes;     /* FIFO bytes served to the library */
+    uint64_t underrun_bytes; /* FIFO bytes requested beyond the recorded data */
+    uint64_t unread_bytes;   /* Recorded FIFO bytes the library did not read */
+    uint32_t register_reads;
+    uint32_t register_writes;
+} replay_hal_stats_t;
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+void replay_hal_init(uint32_t chip_id);
+void replay_hal_load_frame(const uint8_t *data, size_t length);
+size_t replay_hal_pending(void);
+void replay_hal_get_stats(replay_hal_stats_t *stats);
@@ -0,0 +1,347 @@
+/*****************************************************************************
+** File name: selftest.c
+**
+** Description: This file checks the parts of the replay harness that do not
+** need the RadarSensing library. Records are written with the encoder of the
+** application (radar_stream.c) between lines of console text, read back with
+** the capture reader and the recorded frames are served by the HAL emulation
+** to SPI transfers like the ones of the library.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+/* Header file from system */
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Header file includes */
+#include "cy_retarget_io.h"
+
+/* Header file for local module */
+#include "capture_reader.h"
+#include "radar_stream.h"
+#include "replay_hal.h"
+
+/*******************************************************************************
+ * Macros
+ *******************************************************************************/
+#define SELFTEST_CHECK(condition) selftest_check((condition), #condition, __LINE__)
+
+#define SELFTEST_FRAMES (3U)
+/* FIFO data of a frame, like 2 chirps of 64 samples on 3 antennas at 12 bit */
+#define SELFTEST_FRAME_DATA (576U)
+/* Same layout as REPLAY_FRAME_HEADER_SIZE in replay.c */
+#define SELFTEST_FRAME_HEADER (11U)
+#define SELFTEST_BURST (128U)
+/* Register that is written and read back */
+#define SELFTEST_REG (0x10U)
+#define SELFTEST_CAPTURE_SIZE (8192U)
+
+/*******************************************************************************
+ * Global variables
+ *******************************************************************************/
+cyhal_uart_t cy_retarget_io_uart_obj;
+
+static uint8_t capture[SELFTEST_CAPTURE_SIZE];
+static size_t capture_length;
+static uint8_t frames[SELFTEST_FRAMES][SELFTEST_FRAME_HEADER + SELFTEST_FRAME_DATA];
+static uint32_t failures;
+
+/* Console text of the application between the records */
+static const char *const text[] = {
+    "Radar presence application\r\n",
+    "Presence in: 1.25+-0.05 m\r\n",
+    "Presence out\r\n",
+};
+
+/* Parameter lines of the CAPTURE_PARAMS record, after a 4-byte header */
+static const char params[] = "\x01\x00\x00\x00radar_presence_range_max 2.5\nradar_presence_sensitivity high\n";
+
+/*******************************************************************************
+ * Function Name: cyhal_uart_putc
+ ********************************************************************************
+ * Summary:
+ *   Stores the output of radar_stream.c in the capture buffer
+ *
+ * Parameters:
+ *   obj: not used
+ *   value: byte
+ *
+ * Return:
+ *   CY_RSLT_SUCCESS
+ *******************************************************************************/
+cy_rslt_t cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value)
+{
+    (void)obj;
+
+    if (capture_length < sizeof(capture))
+    {
+        capture[capture_length++] = (uint8_t)value;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+ * Function Name: selftest_check
+ ********************************************************************************
+ * Summary:
+ *   Reports a failed check
+ *
+ * Parameters:
+ *   condition: result of the check
+ *   expression: text of the check
+ *   line: source line of the check
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void selftest_check(bool condition, const char *expression, int line)
+{
+    if (!condition)
+    {
+        printf("selftest.c:%d: check failed: %s\n", line, expression);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: selftest_text
+ ********************************************************************************
+ * Summary:
+ *   Adds console text to the capture buffer
+ *
+ * Parameters:
+ *   line: text
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void selftest_text(const char *line)
+{
+    while (*line != '\0')
+    {
+        (void)cyhal_uart_putc(&cy_retarget_io_uart_obj, (uint8_t)*line++);
+    }
+}
+
+/*******************************************************************************
+ * Function Name: selftest_write_capture
+ ********************************************************************************
+ * Summary:
+ *   Writes a capture like the one of a RADAR_CAPTURE build: console text, a
+ *   parameter record and the frame records, followed by a frame record with a
+ *   corrupted byte. The frame data has zeros and runs of more than one COBS
+ *   block without a zero.
+ *
+ * Parameters:
+ *   path: capture file
+ *
+ * Return:
+ *   true if the file was written
+ *******************************************************************************/
+static bool selftest_write_capture(const char *path)
+{
+    FILE *file;
+    bool written;
+
+    for (uint32_t frame = 0; frame < SELFTEST_FRAMES; frame++)
+    {
+        uint8_t *record = frames[frame];
+
+        memset(record, 0, SELFTEST_FRAME_HEADER);
+        record[0] = (uint8_t)frame;
+        record[4] = (uint8_t)(frame * 100U);
+        for (uint32_t i = 0; i < SELFTEST_FRAME_DATA; i++)
+        {
+            record[SELFTEST_FRAME_HEADER + i] = ((i % 300U) == 299U) ? 0U : (uint8_t)(1U + ((i + frame) % 251U));
+        }
+    }
+
+    capture_length = 0U;
+    selftest_text(text[0]);
+    radar_stream_send(RADAR_STREAM_TYPE_CAPTURE_PARAMS, params, sizeof(params) - 1U);
+    for (uint32_t frame = 0; frame < SELFTEST_FRAMES; frame++)
+    {
+        radar_stream_send(RADAR_STREAM_TYPE_CAPTURE_FRAME, frames[frame], sizeof(frames[frame]));
+        selftest_text(text[1U + (frame % 2U)]);
+    }
+
+    size_t corrupted = capture_length + 8U;
+    radar_stream_send(RADAR_STREAM_TYPE_CAPTURE_FRAME, frames[0], sizeof(frames[0]));
+    capture[corrupted] ^= 0x40U;
+    SELFTEST_CHECK(capture_length < sizeof(capture));
+
+    file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return false;
+    }
+    written = (fwrite(capture, 1U, capture_length, file) == capture_length);
+    return (fclose(file) == 0) && written;
+}
+
+/*******************************************************************************
+ * Function Name: selftest_reader
+ ********************************************************************************
+ * Summary:
+ *   Reads the capture back. Every record must come out unchanged, the text
+ *   and the corrupted record must be rejected.
+ *
+ * Parameters:
+ *   path: capture file
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void selftest_reader(const char *path)
+{
+    capture_reader_t reader;
+    capture_record_t record;
+
+    SELFTEST_CHECK(capture_reader_open(&reader, path));
+
+    SELFTEST_CHECK(capture_reader_next(&reader, &record));
+    SELFTEST_CHECK(record.type == RADAR_STREAM_TYPE_CAPTURE_PARAMS);
+    SELFTEST_CHECK((record.length == (sizeof(params) - 1U)) && (memcmp(record.payload, params, record.length) == 0));
+
+    for (uint32_t frame = 0; frame < SELFTEST_FRAMES; frame++)
+    {
+        SELFTEST_CHECK(capture_reader_next(&reader, &record));
+        SELFTEST_CHECK(record.type == RADAR_STREAM_TYPE_CAPTURE_FRAME);
+        SELFTEST_CHECK((record.length == sizeof(frames[frame])) &&
+                       (memcmp(record.payload, frames[frame], record.length) == 0));
+    }
+
+    SELFTEST_CHECK(!capture_reader_next(&reader, &record));
+    SELFTEST_CHECK(reader.records == (1U + SELFTEST_FRAMES));
+    /* One chunk per text line, one for the corrupted record */
+    SELFTEST_CHECK(reader.rejected == (1U + SELFTEST_FRAMES + 1U));
+
+    capture_reader_rewind(&reader);
+    SELFTEST_CHECK(capture_reader_next(&reader, &record) && (record.type == RADAR_STREAM_TYPE_CAPTURE_PARAMS));
+    capture_reader_close(&reader);
+
+    SELFTEST_CHECK(!capture_reader_open(&reader, "/nonexistent/capture.bin"));
+}
+
+/*******************************************************************************
+ * Function Name: selftest_register
+ ********************************************************************************
+ * Summary:
+ *   Accesses a register of the emulated radar like the library does
+ *
+ * Parameters:
+ *   address: register address
+ *   write: true to write the register
+ *   data: value to write
+ *
+ * Return:
+ *   register content before the access
+ *******************************************************************************/
+static uint32_t selftest_register(uint32_t address, bool write, uint32_t data)
+{
+    static cyhal_spi_t spi;
+    uint8_t tx[4] = { (uint8_t)((address << 1) | (write ? 1U : 0U)), (uint8_t)(data >> 16), (uint8_t)(data >> 8),
+                      (uint8_t)data };
+    uint8_t rx[4];
+
+    SELFTEST_CHECK(cyhal_spi_transfer(&spi, tx, sizeof(tx), rx, sizeof(rx), 0xFFU) == CY_RSLT_SUCCESS);
+    return ((uint32_t)rx[1] << 16) | ((uint32_t)rx[2] << 8) | rx[3];
+}
+
+/*******************************************************************************
+ * Function Name: selftest_hal
+ ********************************************************************************
+ * Summary:
+ *   Serves the frames through the HAL emulation. The registers must answer
+ *   with their content, the FIFO bursts with the recorded data, and the IRQ
+ *   pin must follow the pending data.
+ *
+ * Parameters:
+ *   none
+ *
+ * Return:
+ *   none
+ *******************************************************************************/
+static void selftest_hal(void)
+{
+    static cyhal_spi_t spi;
+    uint8_t burst[SELFTEST_FRAME_DATA];
+    replay_hal_stats_t stats;
+
+    replay_hal_init(REPLAY_CHIP_ID_DEFAULT);
+    SELFTEST_CHECK(selftest_register(REPLAY_REG_CHIP_ID, false, 0U) == REPLAY_CHIP_ID_DEFAULT);
+    (void)selftest_register(SELFTEST_REG, true, 0x123456U);
+    SELFTEST_CHECK(selftest_register(SELFTEST_REG, false, 0U) == 0x123456U);
+    SELFTEST_CHECK(!cyhal_gpio_read(REPLAY_PIN_IRQ));
+
+    for (uint32_t frame = 0; frame < SELFTEST_FRAMES; frame++)
+    {
+        replay_hal_load_frame(&frames[frame][SELFTEST_FRAME_HEADER], SELFTEST_FRAME_DATA);
+        SELFTEST_CHECK(cyhal_gpio_read(REPLAY_PIN_IRQ));
+        SELFTEST_CHECK(!cyhal_gpio_read(REPLAY_PIN_SPI_CS));
+
+        for (size_t offset = 0; offset < SELFTEST_FRAME_DATA; offset += SELFTEST_BURST)
+        {
+            size_t length = SELFTEST_FRAME_DATA - offset;
+
+            length = (length < SELFTEST_BURST) ? length : SELFTEST_BURST;
+            SELFTEST_CHECK(cyhal_spi_transfer(&spi, NULL, 0U, &burst[offset], length, 0xFFU) == CY_RSLT_SUCCESS);
+        }
+        SELFTEST_CHECK(memcmp(burst, &frames[frame][SELFTEST_FRAME_HEADER], SELFTEST_FRAME_DATA) == 0);
+        SELFTEST_CHECK(replay_hal_pending() == 0U);
+        SELFTEST_CHECK(!cyhal_gpio_read(REPLAY_PIN_IRQ));
+    }
+
+    /* A burst without recorded data is filled with zeros */
+    memset(burst, 0xFF, SELFTEST_BURST);
+    SELFTEST_CHECK(cyhal_spi_transfer(&spi, NULL, 0U, burst, SELFTEST_BURST, 0xFFU) == CY_RSLT_SUCCESS);
+    SELFTEST_CHECK((burst[0] == 0U) && (burst[SELFTEST_BURST - 1U] == 0U));
+
+    /* Data of a frame that is not read is counted when the next is loaded */
+    replay_hal_load_frame(&frames[0][SELFTEST_FRAME_HEADER], SELFTEST_FRAME_DATA);
+    replay_hal_load_frame(NULL, 0U);
+
+    replay_hal_get_stats(&stats);
+    SELFTEST_CHECK(stats.register_reads == 2U);
+    SELFTEST_CHECK(stats.register_writes == 1U);
+    SELFTEST_CHECK(stats.fifo_bytes == (SELFTEST_FRAMES * SELFTEST_FRAME_DATA));
+    SELFTEST_CHECK(stats.underrun_bytes == SELFTEST_BURST);
+    SELFTEST_CHECK(stats.unread_bytes == SELFTEST_FRAME_DATA);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = (argc > 1) ? argv[1] : "selftest.bin";
+
+    if (!selftest_write_capture(path))
+    {
+        printf("Cannot write %s\n", path);
+        return 1;
+    }
+
+    selftest_reader(path);
+    selftest_hal();
+    (void)remove(path);
+
+    printf("%s: %" PRIu32 " failed checks\n", (failures == 0U) ? "PASS" : "FAIL", failures);
+    return (failures == 0U) ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+/******************************************************************************
+** File name: cy_result.h
+**
+** Description: Host replacement for the result type of the ModusToolbox
+**   core library, used by the replay harness.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdint.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef uint32_t cy_rslt_t;
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define CY_RSLT_SUCCESS ((cy_rslt_t)0x00000000U)
+#define CY_ASSERT(x) do { if (!(x)) { abort(); } } while (0)
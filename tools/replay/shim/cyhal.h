@@ -0,0 +1,91 @@
+/******************************************************************************
+** File name: cyhal.h
+**
+** Description: Host replacement for the subset of the HAL that is used by
+**   the RadarSensing library. The SPI and GPIO functions are emulated in
+**   replay_hal.c, the UART function is provided by the self-test, which
+**   runs the record encoder of the application.
+**
+** ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+
+#pragma once
+
+/* Header file from system */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Header file includes */
+#include "cy_result.h"
+
+/*******************************************************************************
+ * Types
+ *******************************************************************************/
+typedef uint32_t cyhal_gpio_t;
+
+typedef struct
+{
+    uint32_t frequency;
+} cyhal_spi_t;
+
+typedef struct
+{
+    uint32_t baud;
+} cyhal_uart_t;
+
+typedef enum
+{
+    CYHAL_GPIO_DIR_INPUT,
+    CYHAL_GPIO_DIR_OUTPUT,
+    CYHAL_GPIO_DIR_BIDIRECTIONAL
+} cyhal_gpio_direction_t;
+
+typedef enum
+{
+    CYHAL_GPIO_DRIVE_NONE,
+    CYHAL_GPIO_DRIVE_ANALOG,
+    CYHAL_GPIO_DRIVE_PULLUP,
+    CYHAL_GPIO_DRIVE_PULLDOWN,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESLOW,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESHIGH,
+    CYHAL_GPIO_DRIVE_STRONG,
+    CYHAL_GPIO_DRIVE_PULLUPDOWN
+} cyhal_gpio_drive_mode_t;
+
+/*******************************************************************************
+ * Macros
+ ******************************************************************************/
+#define NC ((cyhal_gpio_t)0xFFFFFFFFU)
+
+/*******************************************************************************
+ * Functions
+ *******************************************************************************/
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction, cyhal_gpio_drive_mode_t drive_mode, bool init_val);
+void cyhal_gpio_free(cyhal_gpio_t pin);
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value);
+bool cyhal_gpio_read(cyhal_gpio_t pin);
+void cyhal_gpio_toggle(cyhal_gpio_t pin);
+cy_rslt_t cyhal_spi_transfer(cyhal_spi_t *obj, const uint8_t *tx, size_t tx_length, uint8_t *rx, size_t rx_length, uint8_t write_fill);
+cy_rslt_t cyhal_spi_send(cyhal_spi_t *obj, uint32_t value);
+cy_rslt_t cyhal_spi_recv(cyhal_spi_t *obj, uint32_t *value);
+cy_rslt_t cyhal_system_delay_ms(uint32_t milliseconds);
+void cyhal_system_delay_us(uint16_t microseconds);
+cy_rslt_t cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value);